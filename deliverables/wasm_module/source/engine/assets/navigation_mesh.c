@@ -0,0 +1,906 @@
+#include "navigation_mesh.h"
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../primitives/f32.h"
+#include "../primitives/s32.h"
+#include "../math/vector.h"
+#include "../math/float.h"
+#include "../math/relational.h"
+#include "../../game/project_settings/limits.h"
+#include "../exports/buffers/error.h"
+
+// Portal vertices closer together than this are considered to be the same.
+#define NAVIGATION_MESH_PATH_EPSILON_SQUARED (0.001f * 0.001f)
+
+// The state of the A* search for each face is only valid while its search
+// number matches that of the current search, so that nothing needs clearing
+// between searches.
+static quantity searches;
+static quantity face_searches[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static s32 face_closed[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static f32 face_costs[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static f32 face_estimates[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static index face_parents[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static index face_parent_edges[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static index face_heap_positions[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+
+// A binary min-heap of the faces open for search, ordered by estimate.
+static index heap[MAXIMUM_FACES_PER_NAVIGATION_MESH];
+static quantity heap_size;
+
+static const navigation_mesh *cached_navigation_meshes[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS];
+static index cached_start_faces[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS];
+static index cached_goal_faces[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS];
+
+// The number of edges crossed by each cached path, or INDEX_NONE should its
+// goal face be unreachable.
+static quantity cached_crossings[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS];
+
+// For each cached path, for each edge crossed, the index of that edge within
+// the face being exited.
+static index cached_edges[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS][MAXIMUM_FACES_PER_NAVIGATION_MESH];
+
+// The value of paths at the time each cached path was last used, or 0 should
+// it be empty.
+static quantity cached_paths[MAXIMUM_CACHED_NAVIGATION_MESH_PATHS];
+static quantity paths;
+
+static const navigation_mesh *cached_flow_navigation_meshes[MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS];
+static index cached_flow_goal_faces[MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS];
+
+// For each cached flow field, for each face, the index of the edge to exit
+// through to move towards the goal face, or INDEX_NONE should it be the goal
+// face or unable to reach it.
+static index cached_flow_edges[MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS][MAXIMUM_FACES_PER_NAVIGATION_MESH];
+
+// The value of flows at the time each cached flow field was last used, or 0
+// should it be empty.
+static quantity cached_flows[MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS];
+static quantity flows;
+
+// The ends of each edge crossed, as seen when crossing it, including the start
+// and goal as zero-width edges.
+static const f32 *portal_lefts[MAXIMUM_FACES_PER_NAVIGATION_MESH + 1];
+static const f32 *portal_rights[MAXIMUM_FACES_PER_NAVIGATION_MESH + 1];
+
+// The surface normal of the face exited through each portal, flipped where
+// needed to agree with that before it, which determines which side is which.
+static vector portal_normals[MAXIMUM_FACES_PER_NAVIGATION_MESH + 1];
+
+// The state of the current search of a bounding volume hierarchy.
+static const navigation_mesh *searched_navigation_mesh;
+static const f32 *searched_location;
+static const f32 *searched_direction;
+static f32 nearest_metric;
+static index nearest_face;
+static vector nearest_location;
+
+static void midpoint_of(
+    const navigation_mesh *const navigation_mesh,
+    const index face,
+    const index edge,
+    vector midpoint)
+{
+  const f32 *const vertex_locations = navigation_mesh->vertex_locations[face];
+  const index next = (edge + 1) % navigation_mesh->vertex_counts[face];
+  add_vectors(&vertex_locations[edge * VECTOR_COMPONENTS], &vertex_locations[next * VECTOR_COMPONENTS], midpoint);
+  multiply_vector_by_scalar(midpoint, 0.5f, midpoint);
+}
+
+static void center_of(
+    const navigation_mesh *const navigation_mesh,
+    const index face,
+    vector center)
+{
+  const quantity vertices = navigation_mesh->vertex_counts[face];
+  const f32 *const vertex_locations = navigation_mesh->vertex_locations[face];
+  copy_f32(0.0f, center, VECTOR_COMPONENTS);
+
+  for (index vertex = 0; vertex < vertices; vertex++)
+  {
+    add_vectors(center, &vertex_locations[vertex * VECTOR_COMPONENTS], center);
+  }
+
+  multiply_vector_by_scalar(center, 1.0f / vertices, center);
+}
+
+static void place_in_heap(const index face, const index position)
+{
+  heap[position] = face;
+  face_heap_positions[face] = position;
+}
+
+static void sift_up(const index face)
+{
+  index position = face_heap_positions[face];
+
+  while (position > 0)
+  {
+    const index parent = (position - 1) / 2;
+
+    if (face_estimates[heap[parent]] <= face_estimates[face])
+    {
+      break;
+    }
+
+    place_in_heap(heap[parent], position);
+    position = parent;
+  }
+
+  place_in_heap(face, position);
+}
+
+static index pop_from_heap()
+{
+  const index popped = heap[0];
+  const index face = heap[--heap_size];
+  index position = 0;
+
+  while (1)
+  {
+    index child = position * 2 + 1;
+
+    if (child >= heap_size)
+    {
+      break;
+    }
+
+    if (child + 1 < heap_size && face_estimates[heap[child + 1]] < face_estimates[heap[child]])
+    {
+      child++;
+    }
+
+    if (face_estimates[face] <= face_estimates[heap[child]])
+    {
+      break;
+    }
+
+    place_in_heap(heap[child], position);
+    position = child;
+  }
+
+  place_in_heap(face, position);
+  return popped;
+}
+
+// Costs are measured between the midpoints of the edges crossed, from the
+// center of the start face to the center of the goal face, so that the result
+// only depends upon the faces and can be cached.
+static quantity search(
+    const navigation_mesh *const navigation_mesh,
+    const index start_face,
+    const index goal_face,
+    index *const edges)
+{
+  searches++;
+  heap_size = 0;
+
+  vector goal_center;
+  center_of(navigation_mesh, goal_face, goal_center);
+
+  face_searches[start_face] = searches;
+  face_closed[start_face] = 0;
+  face_costs[start_face] = 0.0f;
+  face_estimates[start_face] = 0.0f;
+  face_parents[start_face] = INDEX_NONE;
+  face_heap_positions[start_face] = heap_size++;
+  sift_up(start_face);
+
+  while (heap_size > 0)
+  {
+    const index face = pop_from_heap();
+
+    if (face == goal_face)
+    {
+      quantity crossings = 0;
+
+      for (index crossed = face; face_parents[crossed] != INDEX_NONE; crossed = face_parents[crossed])
+      {
+        crossings++;
+      }
+
+      index crossing = crossings;
+
+      for (index crossed = face; face_parents[crossed] != INDEX_NONE; crossed = face_parents[crossed])
+      {
+        edges[--crossing] = face_parent_edges[crossed];
+      }
+
+      return crossings;
+    }
+
+    face_closed[face] = 1;
+
+    const quantity face_edges = navigation_mesh->vertex_counts[face];
+    const index parent = face_parents[face];
+    const index entry_edge = parent == INDEX_NONE ? INDEX_NONE : navigation_mesh->neighbor_edges[parent][face_parent_edges[face]];
+
+    for (index edge = 0; edge < face_edges; edge++)
+    {
+      const index neighbor = navigation_mesh->neighbor_faces[face][edge];
+
+      if (neighbor == INDEX_NONE || (face_searches[neighbor] == searches && face_closed[neighbor]))
+      {
+        continue;
+      }
+
+      f32 cost = face_costs[face] + (entry_edge == INDEX_NONE ? navigation_mesh->edge_midpoint_center_distances[face][edge] : navigation_mesh->edge_midpoint_distances[face][entry_edge * face_edges + edge]);
+      f32 remaining;
+
+      if (neighbor == goal_face)
+      {
+        cost += navigation_mesh->edge_midpoint_center_distances[neighbor][navigation_mesh->neighbor_edges[face][edge]];
+        remaining = 0.0f;
+      }
+      else
+      {
+        vector midpoint;
+        midpoint_of(navigation_mesh, face, edge, midpoint);
+        remaining = square_root(distance_squared(midpoint, goal_center));
+      }
+
+      if (face_searches[neighbor] != searches)
+      {
+        face_searches[neighbor] = searches;
+        face_closed[neighbor] = 0;
+        face_heap_positions[neighbor] = heap_size++;
+      }
+      else if (cost >= face_costs[neighbor])
+      {
+        continue;
+      }
+
+      face_costs[neighbor] = cost;
+      face_estimates[neighbor] = cost + remaining;
+      face_parents[neighbor] = face;
+      face_parent_edges[neighbor] = edge;
+      sift_up(neighbor);
+    }
+  }
+
+  return INDEX_NONE;
+}
+
+static index find_cached_path(
+    const navigation_mesh *const navigation_mesh,
+    const index start_face,
+    const index goal_face)
+{
+  for (index path = 0; path < MAXIMUM_CACHED_NAVIGATION_MESH_PATHS; path++)
+  {
+    if (cached_paths[path] && cached_navigation_meshes[path] == navigation_mesh && cached_start_faces[path] == start_face && cached_goal_faces[path] == goal_face)
+    {
+      return path;
+    }
+  }
+
+  return INDEX_NONE;
+}
+
+static index least_recently_used_cached_path()
+{
+  index least_recent = 0;
+
+  for (index path = 1; path < MAXIMUM_CACHED_NAVIGATION_MESH_PATHS; path++)
+  {
+    if (cached_paths[path] < cached_paths[least_recent])
+    {
+      least_recent = path;
+    }
+  }
+
+  return least_recent;
+}
+
+// Twice the signed area of a triangle projected along a normal, which is
+// positive when its vertices wind anticlockwise as viewed from the side which
+// the normal points towards.
+static f32 signed_area(
+    const f32 *const a,
+    const f32 *const b,
+    const f32 *const c,
+    const f32 *const normal)
+{
+  vector first, second;
+  subtract_vectors(b, a, first);
+  subtract_vectors(c, a, second);
+
+  return normal[0] * (first[1] * second[2] - first[2] * second[1]) + normal[1] * (first[2] * second[0] - first[0] * second[2]) + normal[2] * (first[0] * second[1] - first[1] * second[0]);
+}
+
+static s32 same_location(const f32 *const a, const f32 *const b)
+{
+  return distance_squared(a, b) < NAVIGATION_MESH_PATH_EPSILON_SQUARED;
+}
+
+static quantity write_waypoint(
+    const f32 *const location,
+    vector *const waypoints,
+    const quantity maximum_waypoints,
+    const quantity written)
+{
+  // Reaching the end of one side of the funnel at the same time as the end of
+  // the other (or the goal) would otherwise repeat the corner.
+  if (written > 0 && same_location(location, waypoints[written - 1]))
+  {
+    return written;
+  }
+  else if (written < maximum_waypoints)
+  {
+    copy_f32s(location, waypoints[written], VECTOR_COMPONENTS);
+    return written + 1;
+  }
+  else
+  {
+    return written;
+  }
+}
+
+// Pulls the path through the portals taut using the "simple stupid funnel"
+// algorithm; a funnel is narrowed from the latest corner through each portal in
+// turn, and whenever one side would cross the other, the end of that side
+// becomes the next corner.
+static quantity pull(
+    const quantity portals,
+    vector *const waypoints,
+    const quantity maximum_waypoints)
+{
+  quantity written = 0;
+  const f32 *apex = portal_lefts[0];
+  const f32 *left = portal_lefts[0];
+  const f32 *right = portal_rights[0];
+  index left_portal = 0;
+  index right_portal = 0;
+
+  for (index portal = 1; portal < portals && written < maximum_waypoints; portal++)
+  {
+    const f32 *const portal_left = portal_lefts[portal];
+    const f32 *const portal_right = portal_rights[portal];
+    const f32 *const normal = portal_normals[portal];
+
+    if (signed_area(apex, right, portal_right, normal) <= 0.0f)
+    {
+      if (same_location(apex, right) || signed_area(apex, left, portal_right, normal) > 0.0f)
+      {
+        right = portal_right;
+        right_portal = portal;
+      }
+      else
+      {
+        written = write_waypoint(left, waypoints, maximum_waypoints, written);
+        apex = right = left;
+        portal = right_portal = left_portal;
+        continue;
+      }
+    }
+
+    if (signed_area(apex, left, portal_left, normal) >= 0.0f)
+    {
+      if (same_location(apex, left) || signed_area(apex, right, portal_left, normal) < 0.0f)
+      {
+        left = portal_left;
+        left_portal = portal;
+      }
+      else
+      {
+        written = write_waypoint(right, waypoints, maximum_waypoints, written);
+        apex = left = right;
+        portal = left_portal = right_portal;
+        continue;
+      }
+    }
+  }
+
+  return write_waypoint(portal_lefts[portals - 1], waypoints, maximum_waypoints, written);
+}
+
+static void validate(
+    const navigation_mesh *const navigation_mesh,
+    const index start_face,
+    const index goal_face)
+{
+  if (navigation_mesh->count > MAXIMUM_FACES_PER_NAVIGATION_MESH)
+  {
+    throw(ERROR_NAVIGATION_MESH_HAS_TOO_MANY_FACES);
+  }
+
+  if (start_face < 0 || start_face >= navigation_mesh->count || goal_face < 0 || goal_face >= navigation_mesh->count)
+  {
+    throw(ERROR_NAVIGATION_MESH_FACE_INVALID);
+  }
+}
+
+quantity navigation_mesh_path(
+    const navigation_mesh *const navigation_mesh,
+    const index start_face,
+    const vector start,
+    const index goal_face,
+    const vector goal,
+    vector *const waypoints,
+    const quantity maximum_waypoints)
+{
+  validate(navigation_mesh, start_face, goal_face);
+
+  paths++;
+
+  index path = find_cached_path(navigation_mesh, start_face, goal_face);
+
+  if (path == INDEX_NONE)
+  {
+    path = least_recently_used_cached_path();
+    cached_navigation_meshes[path] = navigation_mesh;
+    cached_start_faces[path] = start_face;
+    cached_goal_faces[path] = goal_face;
+    cached_crossings[path] = search(navigation_mesh, start_face, goal_face, cached_edges[path]);
+  }
+
+  cached_paths[path] = paths;
+
+  const quantity crossings = cached_crossings[path];
+
+  if (crossings == INDEX_NONE || maximum_waypoints < 1)
+  {
+    return 0;
+  }
+
+  portal_lefts[0] = portal_rights[0] = start;
+  copy_f32s(&navigation_mesh->surface_normals[start_face * VECTOR_COMPONENTS], portal_normals[0], VECTOR_COMPONENTS);
+  index face = start_face;
+
+  for (index crossing = 0; crossing < crossings; crossing++)
+  {
+    const index edge = cached_edges[path][crossing];
+    const f32 *const vertex_locations = navigation_mesh->vertex_locations[face];
+    const f32 *const first = &vertex_locations[edge * VECTOR_COMPONENTS];
+    const f32 *const second = &vertex_locations[((edge + 1) % navigation_mesh->vertex_counts[face]) * VECTOR_COMPONENTS];
+
+    // Faces may wind either way, so their normals are made to agree with that
+    // of the start face, and which end of the edge is on which side is then
+    // determined from the center of the face being exited.
+    f32 *const normal = portal_normals[crossing + 1];
+    const f32 *const surface_normal = &navigation_mesh->surface_normals[face * VECTOR_COMPONENTS];
+
+    if (dot_product(surface_normal, portal_normals[crossing]) < 0.0f)
+    {
+      multiply_vector_by_scalar(surface_normal, -1.0f, normal);
+    }
+    else
+    {
+      copy_f32s(surface_normal, normal, VECTOR_COMPONENTS);
+    }
+
+    vector center;
+    center_of(navigation_mesh, face, center);
+
+    if (signed_area(center, first, second, normal) > 0.0f)
+    {
+      portal_lefts[crossing + 1] = first;
+      portal_rights[crossing + 1] = second;
+    }
+    else
+    {
+      portal_lefts[crossing + 1] = second;
+      portal_rights[crossing + 1] = first;
+    }
+
+    face = navigation_mesh->neighbor_faces[face][edge];
+  }
+
+  portal_lefts[crossings + 1] = portal_rights[crossings + 1] = goal;
+  copy_f32s(portal_normals[crossings], portal_normals[crossings + 1], VECTOR_COMPONENTS);
+
+  return pull(crossings + 2, waypoints, maximum_waypoints);
+}
+
+static f32 bounding_volume_distance_squared(const index node)
+{
+  const f32 *const minimum = &searched_navigation_mesh->bounding_volume_minimums[node * VECTOR_COMPONENTS];
+  const f32 *const maximum = &searched_navigation_mesh->bounding_volume_maximums[node * VECTOR_COMPONENTS];
+  f32 output = 0.0f;
+
+  for (index component = 0; component < VECTOR_COMPONENTS; component++)
+  {
+    const f32 value = searched_location[component];
+    const f32 outside = value - CLAMP(value, minimum[component], maximum[component]);
+    output += outside * outside;
+  }
+
+  return output;
+}
+
+static void closest_on_face(const index face, vector closest)
+{
+  const quantity edges = searched_navigation_mesh->vertex_counts[face];
+  const f32 *const vertex_locations = searched_navigation_mesh->vertex_locations[face];
+  const f32 *const edge_exit_normals = searched_navigation_mesh->edge_exit_normals[face];
+  s32 within = 1;
+
+  for (index edge = 0; edge < edges; edge++)
+  {
+    vector from_vertex;
+    subtract_vectors(searched_location, &vertex_locations[edge * VECTOR_COMPONENTS], from_vertex);
+
+    if (dot_product(from_vertex, &edge_exit_normals[edge * VECTOR_COMPONENTS]) > 0.0f)
+    {
+      within = 0;
+      break;
+    }
+  }
+
+  if (within)
+  {
+    const f32 *const surface_normal = &searched_navigation_mesh->surface_normals[face * VECTOR_COMPONENTS];
+    vector from_surface, offset;
+    subtract_vectors(searched_location, vertex_locations, from_surface);
+    multiply_vector_by_scalar(surface_normal, dot_product(from_surface, surface_normal), offset);
+    subtract_vectors(searched_location, offset, closest);
+  }
+  else
+  {
+    // Faces are convex, so anything outside of the prism is closest to a point
+    // on one of its edges.
+    const f32 *const edge_coefficients = searched_navigation_mesh->edge_coefficients[face];
+    f32 closest_distance_squared = POSITIVE_INFINITY;
+
+    for (index edge = 0; edge < edges; edge++)
+    {
+      const f32 *const first = &vertex_locations[edge * VECTOR_COMPONENTS];
+      const f32 *const second = &vertex_locations[((edge + 1) % edges) * VECTOR_COMPONENTS];
+      vector from_first, along, on_edge;
+      subtract_vectors(searched_location, first, from_first);
+      const f32 progress = CLAMP(dot_product(from_first, &edge_coefficients[edge * VECTOR_COMPONENTS]), 0.0f, 1.0f);
+      subtract_vectors(second, first, along);
+      multiply_vector_by_scalar(along, progress, along);
+      add_vectors(first, along, on_edge);
+
+      const f32 distance_squared_to_edge = distance_squared(searched_location, on_edge);
+
+      if (distance_squared_to_edge < closest_distance_squared)
+      {
+        closest_distance_squared = distance_squared_to_edge;
+        copy_f32s(on_edge, closest, VECTOR_COMPONENTS);
+      }
+    }
+  }
+}
+
+static void find_closest_face(const index node)
+{
+  const index face = searched_navigation_mesh->bounding_volume_faces[node];
+
+  if (face == INDEX_NONE)
+  {
+    // The nearer child is searched first, so that the further can usually be
+    // skipped entirely.
+    index first = node + 1;
+    index second = searched_navigation_mesh->bounding_volume_second_children[node];
+    f32 first_distance_squared = bounding_volume_distance_squared(first);
+    f32 second_distance_squared = bounding_volume_distance_squared(second);
+
+    if (second_distance_squared < first_distance_squared)
+    {
+      const index swapped = first;
+      first = second;
+      second = swapped;
+      const f32 swapped_distance_squared = first_distance_squared;
+      first_distance_squared = second_distance_squared;
+      second_distance_squared = swapped_distance_squared;
+    }
+
+    if (first_distance_squared < nearest_metric)
+    {
+      find_closest_face(first);
+    }
+
+    if (second_distance_squared < nearest_metric)
+    {
+      find_closest_face(second);
+    }
+  }
+  else
+  {
+    vector closest;
+    closest_on_face(face, closest);
+    const f32 closest_distance_squared = distance_squared(searched_location, closest);
+
+    if (closest_distance_squared < nearest_metric)
+    {
+      nearest_metric = closest_distance_squared;
+      nearest_face = face;
+      copy_f32s(closest, nearest_location, VECTOR_COMPONENTS);
+    }
+  }
+}
+
+index navigation_mesh_closest_face(
+    const navigation_mesh *const navigation_mesh,
+    const vector location,
+    vector closest)
+{
+  searched_navigation_mesh = navigation_mesh;
+  searched_location = location;
+  nearest_metric = POSITIVE_INFINITY;
+  nearest_face = INDEX_NONE;
+  find_closest_face(0);
+  copy_f32s(nearest_location, closest, VECTOR_COMPONENTS);
+  return nearest_face;
+}
+
+// Determines how far along the ray it enters a node's bounds, or
+// POSITIVE_INFINITY should it miss them.
+static f32 bounding_volume_entry(const index node)
+{
+  const f32 *const minimum = &searched_navigation_mesh->bounding_volume_minimums[node * VECTOR_COMPONENTS];
+  const f32 *const maximum = &searched_navigation_mesh->bounding_volume_maximums[node * VECTOR_COMPONENTS];
+  f32 entry = 0.0f;
+  f32 exit = POSITIVE_INFINITY;
+
+  for (index component = 0; component < VECTOR_COMPONENTS; component++)
+  {
+    const f32 origin = searched_location[component];
+    const f32 direction = searched_direction[component];
+
+    if (direction == 0.0f)
+    {
+      if (origin < minimum[component] || origin > maximum[component])
+      {
+        return POSITIVE_INFINITY;
+      }
+    }
+    else
+    {
+      const f32 to_minimum = (minimum[component] - origin) / direction;
+      const f32 to_maximum = (maximum[component] - origin) / direction;
+      entry = MAX(entry, MIN(to_minimum, to_maximum));
+      exit = MIN(exit, MAX(to_minimum, to_maximum));
+    }
+  }
+
+  return entry <= exit ? entry : POSITIVE_INFINITY;
+}
+
+static void find_ray_face(const index node)
+{
+  const index face = searched_navigation_mesh->bounding_volume_faces[node];
+
+  if (face == INDEX_NONE)
+  {
+    index first = node + 1;
+    index second = searched_navigation_mesh->bounding_volume_second_children[node];
+    f32 first_entry = bounding_volume_entry(first);
+    f32 second_entry = bounding_volume_entry(second);
+
+    if (second_entry < first_entry)
+    {
+      const index swapped = first;
+      first = second;
+      second = swapped;
+      const f32 swapped_entry = first_entry;
+      first_entry = second_entry;
+      second_entry = swapped_entry;
+    }
+
+    if (first_entry < nearest_metric)
+    {
+      find_ray_face(first);
+    }
+
+    if (second_entry < nearest_metric)
+    {
+      find_ray_face(second);
+    }
+  }
+  else
+  {
+    const f32 *const vertex_locations = searched_navigation_mesh->vertex_locations[face];
+    const f32 *const surface_normal = &searched_navigation_mesh->surface_normals[face * VECTOR_COMPONENTS];
+    const f32 speed = dot_product(searched_direction, surface_normal);
+
+    if (speed == 0.0f)
+    {
+      return;
+    }
+
+    vector to_surface;
+    subtract_vectors(vertex_locations, searched_location, to_surface);
+    const f32 progress = dot_product(to_surface, surface_normal) / speed;
+
+    if (progress < 0.0f || progress >= nearest_metric)
+    {
+      return;
+    }
+
+    vector location;
+    multiply_vector_by_scalar(searched_direction, progress, location);
+    add_vectors(searched_location, location, location);
+
+    const quantity edges = searched_navigation_mesh->vertex_counts[face];
+    const f32 *const edge_exit_normals = searched_navigation_mesh->edge_exit_normals[face];
+
+    for (index edge = 0; edge < edges; edge++)
+    {
+      vector from_vertex;
+      subtract_vectors(location, &vertex_locations[edge * VECTOR_COMPONENTS], from_vertex);
+
+      if (dot_product(from_vertex, &edge_exit_normals[edge * VECTOR_COMPONENTS]) > 0.0f)
+      {
+        return;
+      }
+    }
+
+    nearest_metric = progress;
+    nearest_face = face;
+    copy_f32s(location, nearest_location, VECTOR_COMPONENTS);
+  }
+}
+
+index navigation_mesh_ray_face(
+    const navigation_mesh *const navigation_mesh,
+    const vector origin,
+    const vector direction,
+    vector hit)
+{
+  searched_navigation_mesh = navigation_mesh;
+  searched_location = origin;
+  searched_direction = direction;
+  nearest_metric = POSITIVE_INFINITY;
+  nearest_face = INDEX_NONE;
+
+  if (bounding_volume_entry(0) < nearest_metric)
+  {
+    find_ray_face(0);
+  }
+
+  if (nearest_face != INDEX_NONE)
+  {
+    copy_f32s(nearest_location, hit, VECTOR_COMPONENTS);
+  }
+
+  return nearest_face;
+}
+
+// Runs Dijkstra's algorithm outwards from the goal face over every face, using
+// the same costs as when finding paths, recording the edge through which each
+// face was reached.
+static void build_flow_field(
+    const navigation_mesh *const navigation_mesh,
+    const index goal_face,
+    index *const edges)
+{
+  for (index face = 0; face < navigation_mesh->count; face++)
+  {
+    edges[face] = INDEX_NONE;
+  }
+
+  searches++;
+  heap_size = 0;
+
+  face_searches[goal_face] = searches;
+  face_closed[goal_face] = 0;
+  face_costs[goal_face] = 0.0f;
+  face_estimates[goal_face] = 0.0f;
+  face_heap_positions[goal_face] = heap_size++;
+  sift_up(goal_face);
+
+  while (heap_size > 0)
+  {
+    const index face = pop_from_heap();
+    face_closed[face] = 1;
+
+    const quantity face_edges = navigation_mesh->vertex_counts[face];
+    const index exit_edge = edges[face];
+
+    for (index edge = 0; edge < face_edges; edge++)
+    {
+      const index neighbor = navigation_mesh->neighbor_faces[face][edge];
+
+      if (neighbor == INDEX_NONE || (face_searches[neighbor] == searches && face_closed[neighbor]))
+      {
+        continue;
+      }
+
+      const f32 cost = face_costs[face] + (exit_edge == INDEX_NONE ? navigation_mesh->edge_midpoint_center_distances[face][edge] : navigation_mesh->edge_midpoint_distances[face][edge * face_edges + exit_edge]);
+
+      if (face_searches[neighbor] != searches)
+      {
+        face_searches[neighbor] = searches;
+        face_closed[neighbor] = 0;
+        face_heap_positions[neighbor] = heap_size++;
+      }
+      else if (cost >= face_costs[neighbor])
+      {
+        continue;
+      }
+
+      face_costs[neighbor] = cost;
+      face_estimates[neighbor] = cost;
+      edges[neighbor] = navigation_mesh->neighbor_edges[face][edge];
+      sift_up(neighbor);
+    }
+  }
+}
+
+static index find_cached_flow_field(
+    const navigation_mesh *const navigation_mesh,
+    const index goal_face)
+{
+  for (index flow = 0; flow < MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS; flow++)
+  {
+    if (cached_flows[flow] && cached_flow_navigation_meshes[flow] == navigation_mesh && cached_flow_goal_faces[flow] == goal_face)
+    {
+      return flow;
+    }
+  }
+
+  return INDEX_NONE;
+}
+
+static index least_recently_used_cached_flow_field()
+{
+  index least_recent = 0;
+
+  for (index flow = 1; flow < MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS; flow++)
+  {
+    if (cached_flows[flow] < cached_flows[least_recent])
+    {
+      least_recent = flow;
+    }
+  }
+
+  return least_recent;
+}
+
+s32 navigation_mesh_flow(
+    const navigation_mesh *const navigation_mesh,
+    const index face,
+    const vector location,
+    const index goal_face,
+    const vector goal,
+    vector direction)
+{
+  validate(navigation_mesh, face, goal_face);
+
+  flows++;
+
+  index flow = find_cached_flow_field(navigation_mesh, goal_face);
+
+  if (flow == INDEX_NONE)
+  {
+    flow = least_recently_used_cached_flow_field();
+    cached_flow_navigation_meshes[flow] = navigation_mesh;
+    cached_flow_goal_faces[flow] = goal_face;
+    build_flow_field(navigation_mesh, goal_face, cached_flow_edges[flow]);
+  }
+
+  cached_flows[flow] = flows;
+
+  vector target;
+
+  if (face == goal_face)
+  {
+    copy_f32s(goal, target, VECTOR_COMPONENTS);
+  }
+  else
+  {
+    const index edge = cached_flow_edges[flow][face];
+
+    if (edge == INDEX_NONE)
+    {
+      copy_f32(0.0f, direction, VECTOR_COMPONENTS);
+      return 0;
+    }
+
+    midpoint_of(navigation_mesh, face, edge, target);
+  }
+
+  subtract_vectors(target, location, direction);
+
+  const f32 magnitude_squared = dot_product(direction, direction);
+
+  if (magnitude_squared > 0.0f)
+  {
+    multiply_vector_by_scalar(direction, 1.0f / square_root(magnitude_squared), direction);
+  }
+
+  return 1;
+}
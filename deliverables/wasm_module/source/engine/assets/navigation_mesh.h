@@ -1,8 +1,14 @@
 /** @file */
 
+#ifndef NAVIGATION_MESH_H
+
+#define NAVIGATION_MESH_H
+
 #include "../primitives/f32.h"
 #include "../primitives/index.h"
 #include "../primitives/quantity.h"
+#include "../primitives/s32.h"
+#include "../math/vector.h"
 
 /**
  * An immutable mesh used for navigation.
@@ -78,6 +84,34 @@ typedef struct
    * that edge and the average of the face's vertices.
    */
   const f32 *const *const edge_midpoint_center_distances;
+
+  /**
+   * For each node of a bounding volume hierarchy over the faces (in depth-first
+   * order, starting from the root), a three-dimensional vector representing
+   * the minimum of the bounds of every face within.
+   */
+  const f32 *const bounding_volume_minimums;
+
+  /**
+   * For each node of a bounding volume hierarchy over the faces (in depth-first
+   * order, starting from the root), a three-dimensional vector representing
+   * the maximum of the bounds of every face within.
+   */
+  const f32 *const bounding_volume_maximums;
+
+  /**
+   * For each node of a bounding volume hierarchy over the faces (in depth-first
+   * order, starting from the root), the index of its second child, or
+   * INDEX_NONE should it be a leaf.  Its first child immediately follows it.
+   */
+  const index *const bounding_volume_second_children;
+
+  /**
+   * For each node of a bounding volume hierarchy over the faces (in depth-first
+   * order, starting from the root), the index of the face within should it be
+   * a leaf, or INDEX_NONE should it not.
+   */
+  const index *const bounding_volume_faces;
 } navigation_mesh;
 
 /**
@@ -85,3 +119,105 @@ typedef struct
  * @return The provided navigation mesh.
  */
 typedef const navigation_mesh *(navigation_mesh_factory)();
+
+/**
+ * Finds the face of a navigation mesh closest to a location.
+ * @remark Searches a bounding volume hierarchy built when the navigation mesh
+ *         was, so costs roughly the logarithm of the number of faces.
+ * @param navigation_mesh The navigation mesh to search.
+ * @param location The location to search from.
+ * @param closest Written to with the closest location on the face found.
+ *                Equal to location projected onto the face's surface when
+ *                location is within the face's prism.
+ * @return The index of the face closest to the location.
+ */
+index navigation_mesh_closest_face(
+    const navigation_mesh *const navigation_mesh,
+    const vector location,
+    vector closest);
+
+/**
+ * Finds the first face of a navigation mesh hit by a ray.
+ * @remark Searches a bounding volume hierarchy built when the navigation mesh
+ *         was, so costs roughly the logarithm of the number of faces.
+ * @remark Faces are hit from either side.
+ * @param navigation_mesh The navigation mesh to search.
+ * @param origin The location from which the ray is cast.
+ * @param direction The direction in which the ray is cast.  Need not be
+ *                  normalized.  The ray does not end.
+ * @param hit Written to with the location at which the ray hit the face found.
+ *            Unchanged should nothing be hit.
+ * @return The index of the first face hit, or INDEX_NONE should nothing be
+ *         hit.
+ */
+index navigation_mesh_ray_face(
+    const navigation_mesh *const navigation_mesh,
+    const vector origin,
+    const vector direction,
+    vector hit);
+
+/**
+ * Finds the shortest path between two locations on a navigation mesh.
+ * @remark Faces are chosen using A* over the edges between them, costed using
+ *         the distances between their midpoints, then the path through them is
+ *         pulled taut along their surfaces (as viewed along their normals), so
+ *         navigation meshes may lie in any plane.
+ * @remark The faces chosen only depend upon the start and goal faces, and are
+ *         cached (see @ref MAXIMUM_CACHED_NAVIGATION_MESH_PATHS), so repeatedly
+ *         finding paths between the same faces is much cheaper than the first.
+ * @remark Will throw a trap should either face not exist.
+ * @remark Will throw a trap should the navigation mesh have more faces than
+ *         @ref MAXIMUM_FACES_PER_NAVIGATION_MESH.
+ * @param navigation_mesh The navigation mesh to find a path over.
+ * @param start_face The index of the face within which the path starts.
+ * @param start The location at which the path starts.
+ * @param goal_face The index of the face within which the path ends.
+ * @param goal The location at which the path ends.
+ * @param waypoints Written to with each location to move towards in turn,
+ *                  excluding the start and ending with the goal.  Should there
+ *                  be more than will fit, only the first are written.
+ * @param maximum_waypoints The number of waypoints which will fit.
+ * @return The number of waypoints written, or 0 should the goal face not be
+ *         reachable from the start face.
+ */
+quantity navigation_mesh_path(
+    const navigation_mesh *const navigation_mesh,
+    const index start_face,
+    const vector start,
+    const index goal_face,
+    const vector goal,
+    vector *const waypoints,
+    const quantity maximum_waypoints);
+
+/**
+ * Determines which way to move to follow the flow field towards a goal on a
+ * navigation mesh.  Much cheaper than @ref navigation_mesh_path when many
+ * agents share the same goal face.
+ * @remark The first call for a goal face visits every face of the navigation
+ *         mesh to determine which edge of each to exit through to reach the
+ *         goal face soonest.  This flow field is cached (see
+ *         @ref MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS), so further calls
+ *         for the same goal face only look up the face being moved from.
+ * @remark Will throw a trap should either face not exist.
+ * @remark Will throw a trap should the navigation mesh have more faces than
+ *         @ref MAXIMUM_FACES_PER_NAVIGATION_MESH.
+ * @param navigation_mesh The navigation mesh to move over.
+ * @param face The index of the face within which to move from.
+ * @param location The location to move from.
+ * @param goal_face The index of the face within which the goal is.
+ * @param goal The location of the goal.
+ * @param direction Written to with a unit vector pointing towards the midpoint
+ *                  of the edge to exit through, or towards the goal within the
+ *                  goal face.  Zero should the goal face not be reachable, or
+ *                  the location be the goal.
+ * @return Non-zero should the goal face be reachable, otherwise zero.
+ */
+s32 navigation_mesh_flow(
+    const navigation_mesh *const navigation_mesh,
+    const index face,
+    const vector location,
+    const index goal_face,
+    const vector goal,
+    vector direction);
+
+#endif
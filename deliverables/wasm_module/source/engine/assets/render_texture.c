@@ -0,0 +1,20 @@
+#include "../primitives/f32.h"
+#include "texture.h"
+#include "render_texture.h"
+#include "../../game/project_settings/video_settings.h"
+
+#define RENDER_TEXTURE_DEFINITION(name, rows, columns)                                                                                                                                             \
+  static f32 name##_opacities[(rows) * (columns)];                                                                                                                                                 \
+  static f32 name##_reds[(rows) * (columns)];                                                                                                                                                      \
+  static f32 name##_greens[(rows) * (columns)];                                                                                                                                                    \
+  static f32 name##_blues[(rows) * (columns)];                                                                                                                                                     \
+  static f32 name##_depths[(rows) * (columns)];                                                                                                                                                    \
+                                                                                                                                                                                                   \
+  render_texture name##_render_texture = {{rows, columns, name##_opacities, name##_reds, name##_greens, name##_blues}, name##_opacities, name##_reds, name##_greens, name##_blues, name##_depths}; \
+                                                                                                                                                                                                   \
+  const texture *name()                                                                                                                                                                            \
+  {                                                                                                                                                                                                \
+    return &name##_render_texture.sampled;                                                                                                                                                         \
+  }
+
+RENDER_TEXTURE_LIST(RENDER_TEXTURE_DEFINITION)
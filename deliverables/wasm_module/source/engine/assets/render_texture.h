@@ -0,0 +1,66 @@
+/** @file */
+
+#ifndef RENDER_TEXTURE_H
+
+#define RENDER_TEXTURE_H
+
+#include "../primitives/f32.h"
+#include "texture.h"
+#include "../../game/project_settings/video_settings.h"
+
+/**
+ * A texture owned by the engine which camera components can render into.  See
+ * @ref RENDER_TEXTURE_LIST.
+ */
+typedef struct
+{
+  /**
+   * The texture which meshes sample.
+   */
+  const texture sampled;
+
+  /**
+   * The opacity of each pixel within the texture, row-major.
+   * @remark Written to by camera components.
+   */
+  f32 *const opacities;
+
+  /**
+   * The intensity of the red channel of each pixel within the texture,
+   * row-major.
+   * @remark Written to by camera components.
+   */
+  f32 *const reds;
+
+  /**
+   * The intensity of the green channel of each pixel within the texture,
+   * row-major.
+   * @remark Written to by camera components.
+   */
+  f32 *const greens;
+
+  /**
+   * The intensity of the blue channel of each pixel within the texture,
+   * row-major.
+   * @remark Written to by camera components.
+   */
+  f32 *const blues;
+
+  /**
+   * The depth buffer, row-major, where -1 is near and 1 is far, non-linear.
+   * @remark Written to by camera components.
+   */
+  f32 *const depths;
+} render_texture;
+
+#ifndef DOXYGEN_IGNORE
+
+#define RENDER_TEXTURE_DECLARATION(name, rows, columns) \
+  extern render_texture name##_render_texture;          \
+  const texture *name();
+
+RENDER_TEXTURE_LIST(RENDER_TEXTURE_DECLARATION)
+
+#endif
+
+#endif
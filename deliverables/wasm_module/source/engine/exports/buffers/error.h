@@ -67,6 +67,65 @@
  */
 #define ERROR_NO_TICK_COMPONENTS_TO_ALLOCATE -11
 
+/**
+ * Indicates that development builds found the component hierarchy to be
+ * internally inconsistent.
+ */
+#define ERROR_COMPONENT_HIERARCHY_INCONSISTENT -12
+
+/**
+ * Indicates that an entity was attached to itself or one of its descendants.
+ */
+#define ERROR_ENTITY_PARENT_CYCLE -13
+
+/**
+ * Indicates that a tick component was given a phase which does not exist.
+ */
+#define ERROR_TICK_COMPONENT_PHASE_INVALID -14
+
+/**
+ * Indicates that no timer components were left to allocate.
+ */
+#define ERROR_NO_TIMER_COMPONENTS_TO_ALLOCATE -15
+
+/**
+ * Indicates that a timer component was given a duration of less than one tick.
+ */
+#define ERROR_TIMER_COMPONENT_DURATION_INVALID -16
+
+/**
+ * Indicates that no selectable components were left to allocate.
+ */
+#define ERROR_NO_SELECTABLE_COMPONENTS_TO_ALLOCATE -17
+
+/**
+ * Indicates that a selectable component was added to an entity which already
+ * has one.
+ */
+#define ERROR_ENTITY_ALREADY_SELECTABLE -18
+
+/**
+ * Indicates that no navigation mesh components were left to allocate.
+ */
+#define ERROR_NO_NAVIGATION_MESH_COMPONENTS_TO_ALLOCATE -19
+
+/**
+ * Indicates that a navigation mesh component was placed on, or a path was
+ * requested between, a face which does not exist.
+ */
+#define ERROR_NAVIGATION_MESH_FACE_INVALID -20
+
+/**
+ * Indicates that a path was requested over a navigation mesh with more faces
+ * than MAXIMUM_FACES_PER_NAVIGATION_MESH.
+ */
+#define ERROR_NAVIGATION_MESH_HAS_TOO_MANY_FACES -21
+
+/**
+ * Indicates that the entity of a navigation mesh component has a parent.
+ */
+#define ERROR_NAVIGATION_MESH_COMPONENT_ENTITY_HAS_PARENT -22
+
 /**
  * The error number readable by the hosting platform at the end of the current
  * event handler.  Positive values are generated by the game, while negative
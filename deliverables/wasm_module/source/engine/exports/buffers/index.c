@@ -18,31 +18,33 @@ const quantity maximum_video_rows ALIGN(s32) = MAXIMUM_VIDEO_ROWS;
 const quantity safe_area_rows ALIGN(s32) = SAFE_AREA_ROWS;
 const quantity safe_area_columns ALIGN(s32) = SAFE_AREA_COLUMNS;
 
-#define BUFFER_LIST(item)                                                                                                   \
-  item(1073741824, ticks_per_second)                                                                                        \
-      item(1073741825, audio_samples)                                                                                       \
-          item(1073741826, maximum_video_rows)                                                                              \
-              item(1073741827, safe_area_rows)                                                                              \
-                  item(1073741828, safe_area_columns)                                                                       \
-                      item(1073741829, video_reds)                                                                          \
-                          item(1073741830, pointer_state)                                                                   \
-                              item(1073741831, pointer_row)                                                                 \
-                                  item(1073741832, pointer_column)                                                          \
-                                      item(1073741833, persist)                                                             \
-                                          item(1073741834, tick_progress)                                                   \
-                                              item(1073741835, video_rows)                                                  \
-                                                  item(1073741836, video_columns)                                           \
-                                                      item(1073741837, listener_location)                                   \
-                                                          item(1073741838, listener_normal)                                 \
-                                                              item(1073741839, controller_states)                           \
-                                                                  item(1073741840, controller_y_axes)                       \
-                                                                      item(1073741841, controller_x_axes)                   \
-                                                                          item(1073741842, error)                           \
-                                                                              item(536870912, current_script)               \
-                                                                                  item(1073741843, video_greens)            \
-                                                                                      item(1073741844, video_blues)         \
-                                                                                          item(1073741845, video_opacities) \
-                                                                                              item(1073741846, video_depths)
+#define BUFFER_LIST(item)                                                                                                           \
+  item(1073741824, ticks_per_second)                                                                                                \
+      item(1073741825, audio_samples)                                                                                               \
+          item(1073741826, maximum_video_rows)                                                                                      \
+              item(1073741827, safe_area_rows)                                                                                      \
+                  item(1073741828, safe_area_columns)                                                                               \
+                      item(1073741829, video_reds)                                                                                  \
+                          item(1073741830, pointer_state)                                                                           \
+                              item(1073741831, pointer_row)                                                                         \
+                                  item(1073741832, pointer_column)                                                                  \
+                                      item(1073741833, persist)                                                                     \
+                                          item(1073741834, tick_progress)                                                           \
+                                              item(1073741835, video_rows)                                                          \
+                                                  item(1073741836, video_columns)                                                   \
+                                                      item(1073741837, listener_location)                                           \
+                                                          item(1073741838, listener_normal)                                         \
+                                                              item(1073741839, controller_states)                                   \
+                                                                  item(1073741840, controller_y_axes)                               \
+                                                                      item(1073741841, controller_x_axes)                           \
+                                                                          item(1073741842, error)                                   \
+                                                                              item(536870912, current_script)                       \
+                                                                                  item(1073741843, video_greens)                    \
+                                                                                      item(1073741844, video_blues)                 \
+                                                                                          item(1073741845, video_opacities)         \
+                                                                                              item(1073741846, video_depths)        \
+                                                                                                  item(1073741847, video_unchanged) \
+                                                                                                      item(1073741848, video_dirty_rectangles)
 
 #define BUFFER_NULL(identifier, data) NULL,
 
@@ -3,6 +3,7 @@
 #include "../../primitives/f32.h"
 #include "../../primitives/quantity.h"
 #include "../../../game/project_settings/video_settings.h"
+#include "../../../game/project_settings/limits.h"
 #include "../export.h"
 
 quantity video_rows ALIGN(s32) = MAXIMUM_VIDEO_ROWS;
@@ -17,3 +18,7 @@ f32 video_depths[MAXIMUM_VIDEO_ROWS * MAXIMUM_VIDEO_COLUMNS] ALIGN(f32);
 
 f32 tick_progress ALIGN(f32) = 1;
 f32 inverse_tick_progress;
+
+s32 video_unchanged ALIGN(s32);
+s32 video_dirty_rectangles[MAXIMUM_CAMERA_COMPONENTS * 4] ALIGN(s32);
+s32 video_invalidated = 1;
@@ -4,9 +4,11 @@
 
 #define VIDEO_H
 
+#include "../../primitives/s32.h"
 #include "../../primitives/quantity.h"
 #include "../../primitives/f32.h"
 #include "../../../game/project_settings/video_settings.h"
+#include "../../../game/project_settings/limits.h"
 
 /**
  * The height of the video buffer, in pixel rows.
@@ -61,4 +63,35 @@ extern f32 tick_progress;
  */
 extern f32 inverse_tick_progress;
 
+/**
+ * Non-zero when the most recent video event handler found that nothing visible
+ * had changed since the previous, and so left the video buffers as they were.
+ * @remark The hosting runtime may use this to skip converting and presenting
+ *         the video buffers.
+ */
+extern s32 video_unchanged;
+
+/**
+ * The rectangles of the video buffer written to or cleared by the most recent
+ * video event handler, in groups of four: the number of rows between the top of
+ * the video buffer and the top of the rectangle, the number of columns between
+ * the left of the video buffer and the left of the rectangle, the height of the
+ * rectangle in pixel rows and the width of the rectangle in pixel columns.
+ * @remark Rectangles with a height or width of 0 are unused.
+ * @remark Pixels outside of all rectangles are unchanged since the previous
+ *         video event handler.
+ */
+extern s32 video_dirty_rectangles[MAXIMUM_CAMERA_COMPONENTS * 4];
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * Non-zero when something which cannot be detected by comparing interpolated
+ * values (such as the creation or destruction of a component) has occurred
+ * since the previous video event handler, forcing the next to re-render.
+ */
+extern s32 video_invalidated;
+
+#endif
+
 #endif
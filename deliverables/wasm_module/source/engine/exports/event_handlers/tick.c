@@ -2,14 +2,32 @@
 #include "event_handler.h"
 #include "../../scenes/components/tick_component.h"
 #include "../../scenes/components/timer_component.h"
+#include "../../scenes/components/selectable_component.h"
+#include "../../scenes/components/navigation_mesh_component.h"
+#include "../../scenes/components/component.h"
+#include "../../scenes/entity.h"
 
 EXPORT void tick()
 {
   initialize_event_handler();
 
+  index_entities_spatially();
+
   before_executing_tick_components();
   before_executing_timer_components();
 
+  execute_selectable_components();
+
   execute_tick_components();
   execute_timer_components();
+  execute_navigation_mesh_components();
+
+  destroy_deferred_entities();
+  destroy_deferred_components();
+
+  invalidate_entity_motion();
+
+#ifdef DEVELOPMENT
+  validate_components();
+#endif
 }
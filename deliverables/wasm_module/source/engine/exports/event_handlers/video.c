@@ -4,7 +4,15 @@
 #include "../../scenes/entity.h"
 #include "../../scenes/components/camera_component.h"
 #include "../../scenes/components/mesh_component.h"
+#include "../../scenes/components/selectable_component.h"
 #include "../../primitives/f32.h"
+#include "../../primitives/s32.h"
+#include "../../primitives/quantity.h"
+#include "../../primitives/index.h"
+#include "../../../game/project_settings/limits.h"
+
+static quantity rendered_video_rows;
+static quantity rendered_video_columns;
 
 static void render()
 {
@@ -21,8 +29,33 @@ EXPORT void video()
   initialize_event_handler();
   inverse_tick_progress = 1.0f - tick_progress;
 
-  copy_f32(0.0f, video_opacities, video_rows * video_columns);
+  for (index index = 0; index < MAXIMUM_CAMERA_COMPONENTS * 4; index++)
+  {
+    video_dirty_rectangles[index] = 0;
+  }
+
+  clear_entity_layers();
+  prepare_mesh_components_for_video();
+
+  const s32 entity_changed_layers = prepare_entities_for_video();
+  const s32 changed_layers = video_invalidated ? -1 : entity_changed_layers;
+  const s32 camera_components_changed = prepare_camera_components_for_video(changed_layers);
+  const s32 selectable_components_changed = prepare_selectable_components_for_video();
+
+  if (changed_layers || camera_components_changed || selectable_components_changed || video_rows != rendered_video_rows || video_columns != rendered_video_columns)
+  {
+    video_invalidated = 0;
+    video_unchanged = 0;
+    rendered_video_rows = video_rows;
+    rendered_video_columns = video_columns;
+
+    copy_f32(0.0f, video_opacities, video_rows * video_columns);
+    selectable_component_picked = INDEX_NONE;
 
-  prepare_entities_for_video();
-  render_camera_components(render);
+    render_camera_components(render);
+  }
+  else
+  {
+    video_unchanged = 1;
+  }
 }
@@ -1,6 +1,34 @@
 #include "matrix.h"
 #include "relational.h"
 #include "trigonometry.h"
+#include "../miscellaneous.h"
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+
+// Where available, matrix rows are multiplied and accumulated as four-lane
+// vectors, which matches the order of operations (and so the results) of the
+// scalar implementations.
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MATRIX_ROWS_VECTORIZED
+typedef v128_t matrix_row;
+#define MATRIX_ROW_LOAD(source) wasm_v128_load(source)
+#define MATRIX_ROW_STORE(destination, row) wasm_v128_store(destination, row)
+#define MATRIX_ROW_SPLAT(value) wasm_f32x4_splat(value)
+#define MATRIX_ROW_W(value) wasm_f32x4_make(0.0f, 0.0f, 0.0f, value)
+#define MATRIX_ROW_ADD(a, b) wasm_f32x4_add(a, b)
+#define MATRIX_ROW_MULTIPLY(a, b) wasm_f32x4_mul(a, b)
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#define MATRIX_ROWS_VECTORIZED
+typedef __m128 matrix_row;
+#define MATRIX_ROW_LOAD(source) _mm_loadu_ps(source)
+#define MATRIX_ROW_STORE(destination, row) _mm_storeu_ps(destination, row)
+#define MATRIX_ROW_SPLAT(value) _mm_set1_ps(value)
+#define MATRIX_ROW_W(value) _mm_set_ps(value, 0.0f, 0.0f, 0.0f)
+#define MATRIX_ROW_ADD(a, b) _mm_add_ps(a, b)
+#define MATRIX_ROW_MULTIPLY(a, b) _mm_mul_ps(a, b)
+#endif
 
 const matrix identity_matrix = {
     {1.0f, 0.0f, 0.0f, 0.0f},
@@ -80,6 +108,24 @@ void multiply_matrices(
     const matrix multiplicand,
     matrix product)
 {
+#ifdef MATRIX_ROWS_VECTORIZED
+  const matrix_row multiplicand_0 = MATRIX_ROW_LOAD(multiplicand[0]);
+  const matrix_row multiplicand_1 = MATRIX_ROW_LOAD(multiplicand[1]);
+  const matrix_row multiplicand_2 = MATRIX_ROW_LOAD(multiplicand[2]);
+  const matrix_row multiplicand_3 = MATRIX_ROW_LOAD(multiplicand[3]);
+
+  // Each row of the product depends only upon the same row of the multiplier,
+  // so either input may also be the output.
+  for (index row = 0; row < 4; row++)
+  {
+    const f32 *const multiplier_row = multiplier[row];
+    matrix_row product_row = MATRIX_ROW_MULTIPLY(multiplicand_0, MATRIX_ROW_SPLAT(multiplier_row[0]));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_1, MATRIX_ROW_SPLAT(multiplier_row[1])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_2, MATRIX_ROW_SPLAT(multiplier_row[2])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_3, MATRIX_ROW_SPLAT(multiplier_row[3])));
+    MATRIX_ROW_STORE(product[row], product_row);
+  }
+#else
   const f32 multiplier_0_0 = multiplier[0][0];
   const f32 multiplier_0_1 = multiplier[0][1];
   const f32 multiplier_0_2 = multiplier[0][2];
@@ -130,6 +176,146 @@ void multiply_matrices(
   product[3][1] = multiplicand_0_1 * multiplier_3_0 + multiplicand_1_1 * multiplier_3_1 + multiplicand_2_1 * multiplier_3_2 + multiplicand_3_1 * multiplier_3_3;
   product[3][2] = multiplicand_0_2 * multiplier_3_0 + multiplicand_1_2 * multiplier_3_1 + multiplicand_2_2 * multiplier_3_2 + multiplicand_3_2 * multiplier_3_3;
   product[3][3] = multiplicand_0_3 * multiplier_3_0 + multiplicand_1_3 * multiplier_3_1 + multiplicand_2_3 * multiplier_3_2 + multiplicand_3_3 * multiplier_3_3;
+#endif
+}
+
+void multiply_matrix_by_affine_matrix(
+    const matrix multiplier,
+    const matrix multiplicand,
+    matrix product)
+{
+#ifdef MATRIX_ROWS_VECTORIZED
+  const matrix_row multiplicand_0 = MATRIX_ROW_LOAD(multiplicand[0]);
+  const matrix_row multiplicand_1 = MATRIX_ROW_LOAD(multiplicand[1]);
+  const matrix_row multiplicand_2 = MATRIX_ROW_LOAD(multiplicand[2]);
+
+  // Each row of the product depends only upon the same row of the multiplier,
+  // so either input may also be the output.
+  for (index row = 0; row < 4; row++)
+  {
+    const f32 *const multiplier_row = multiplier[row];
+    matrix_row product_row = MATRIX_ROW_MULTIPLY(multiplicand_0, MATRIX_ROW_SPLAT(multiplier_row[0]));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_1, MATRIX_ROW_SPLAT(multiplier_row[1])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_2, MATRIX_ROW_SPLAT(multiplier_row[2])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_W(multiplier_row[3]));
+    MATRIX_ROW_STORE(product[row], product_row);
+  }
+#else
+  const f32 multiplier_0_0 = multiplier[0][0];
+  const f32 multiplier_0_1 = multiplier[0][1];
+  const f32 multiplier_0_2 = multiplier[0][2];
+  const f32 multiplier_0_3 = multiplier[0][3];
+  const f32 multiplier_1_0 = multiplier[1][0];
+  const f32 multiplier_1_1 = multiplier[1][1];
+  const f32 multiplier_1_2 = multiplier[1][2];
+  const f32 multiplier_1_3 = multiplier[1][3];
+  const f32 multiplier_2_0 = multiplier[2][0];
+  const f32 multiplier_2_1 = multiplier[2][1];
+  const f32 multiplier_2_2 = multiplier[2][2];
+  const f32 multiplier_2_3 = multiplier[2][3];
+  const f32 multiplier_3_0 = multiplier[3][0];
+  const f32 multiplier_3_1 = multiplier[3][1];
+  const f32 multiplier_3_2 = multiplier[3][2];
+  const f32 multiplier_3_3 = multiplier[3][3];
+
+  const f32 multiplicand_0_0 = multiplicand[0][0];
+  const f32 multiplicand_0_1 = multiplicand[0][1];
+  const f32 multiplicand_0_2 = multiplicand[0][2];
+  const f32 multiplicand_0_3 = multiplicand[0][3];
+  const f32 multiplicand_1_0 = multiplicand[1][0];
+  const f32 multiplicand_1_1 = multiplicand[1][1];
+  const f32 multiplicand_1_2 = multiplicand[1][2];
+  const f32 multiplicand_1_3 = multiplicand[1][3];
+  const f32 multiplicand_2_0 = multiplicand[2][0];
+  const f32 multiplicand_2_1 = multiplicand[2][1];
+  const f32 multiplicand_2_2 = multiplicand[2][2];
+  const f32 multiplicand_2_3 = multiplicand[2][3];
+
+  product[0][0] = multiplicand_0_0 * multiplier_0_0 + multiplicand_1_0 * multiplier_0_1 + multiplicand_2_0 * multiplier_0_2;
+  product[0][1] = multiplicand_0_1 * multiplier_0_0 + multiplicand_1_1 * multiplier_0_1 + multiplicand_2_1 * multiplier_0_2;
+  product[0][2] = multiplicand_0_2 * multiplier_0_0 + multiplicand_1_2 * multiplier_0_1 + multiplicand_2_2 * multiplier_0_2;
+  product[0][3] = multiplicand_0_3 * multiplier_0_0 + multiplicand_1_3 * multiplier_0_1 + multiplicand_2_3 * multiplier_0_2 + multiplier_0_3;
+  product[1][0] = multiplicand_0_0 * multiplier_1_0 + multiplicand_1_0 * multiplier_1_1 + multiplicand_2_0 * multiplier_1_2;
+  product[1][1] = multiplicand_0_1 * multiplier_1_0 + multiplicand_1_1 * multiplier_1_1 + multiplicand_2_1 * multiplier_1_2;
+  product[1][2] = multiplicand_0_2 * multiplier_1_0 + multiplicand_1_2 * multiplier_1_1 + multiplicand_2_2 * multiplier_1_2;
+  product[1][3] = multiplicand_0_3 * multiplier_1_0 + multiplicand_1_3 * multiplier_1_1 + multiplicand_2_3 * multiplier_1_2 + multiplier_1_3;
+  product[2][0] = multiplicand_0_0 * multiplier_2_0 + multiplicand_1_0 * multiplier_2_1 + multiplicand_2_0 * multiplier_2_2;
+  product[2][1] = multiplicand_0_1 * multiplier_2_0 + multiplicand_1_1 * multiplier_2_1 + multiplicand_2_1 * multiplier_2_2;
+  product[2][2] = multiplicand_0_2 * multiplier_2_0 + multiplicand_1_2 * multiplier_2_1 + multiplicand_2_2 * multiplier_2_2;
+  product[2][3] = multiplicand_0_3 * multiplier_2_0 + multiplicand_1_3 * multiplier_2_1 + multiplicand_2_3 * multiplier_2_2 + multiplier_2_3;
+  product[3][0] = multiplicand_0_0 * multiplier_3_0 + multiplicand_1_0 * multiplier_3_1 + multiplicand_2_0 * multiplier_3_2;
+  product[3][1] = multiplicand_0_1 * multiplier_3_0 + multiplicand_1_1 * multiplier_3_1 + multiplicand_2_1 * multiplier_3_2;
+  product[3][2] = multiplicand_0_2 * multiplier_3_0 + multiplicand_1_2 * multiplier_3_1 + multiplicand_2_2 * multiplier_3_2;
+  product[3][3] = multiplicand_0_3 * multiplier_3_0 + multiplicand_1_3 * multiplier_3_1 + multiplicand_2_3 * multiplier_3_2 + multiplier_3_3;
+#endif
+}
+
+void multiply_affine_matrices(
+    const matrix multiplier,
+    const matrix multiplicand,
+    matrix product)
+{
+#ifdef MATRIX_ROWS_VECTORIZED
+  const matrix_row multiplicand_0 = MATRIX_ROW_LOAD(multiplicand[0]);
+  const matrix_row multiplicand_1 = MATRIX_ROW_LOAD(multiplicand[1]);
+  const matrix_row multiplicand_2 = MATRIX_ROW_LOAD(multiplicand[2]);
+
+  // Each row of the product depends only upon the same row of the multiplier,
+  // so either input may also be the output.
+  for (index row = 0; row < 3; row++)
+  {
+    const f32 *const multiplier_row = multiplier[row];
+    matrix_row product_row = MATRIX_ROW_MULTIPLY(multiplicand_0, MATRIX_ROW_SPLAT(multiplier_row[0]));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_1, MATRIX_ROW_SPLAT(multiplier_row[1])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_MULTIPLY(multiplicand_2, MATRIX_ROW_SPLAT(multiplier_row[2])));
+    product_row = MATRIX_ROW_ADD(product_row, MATRIX_ROW_W(multiplier_row[3]));
+    MATRIX_ROW_STORE(product[row], product_row);
+  }
+#else
+  const f32 multiplier_0_0 = multiplier[0][0];
+  const f32 multiplier_0_1 = multiplier[0][1];
+  const f32 multiplier_0_2 = multiplier[0][2];
+  const f32 multiplier_0_3 = multiplier[0][3];
+  const f32 multiplier_1_0 = multiplier[1][0];
+  const f32 multiplier_1_1 = multiplier[1][1];
+  const f32 multiplier_1_2 = multiplier[1][2];
+  const f32 multiplier_1_3 = multiplier[1][3];
+  const f32 multiplier_2_0 = multiplier[2][0];
+  const f32 multiplier_2_1 = multiplier[2][1];
+  const f32 multiplier_2_2 = multiplier[2][2];
+  const f32 multiplier_2_3 = multiplier[2][3];
+
+  const f32 multiplicand_0_0 = multiplicand[0][0];
+  const f32 multiplicand_0_1 = multiplicand[0][1];
+  const f32 multiplicand_0_2 = multiplicand[0][2];
+  const f32 multiplicand_0_3 = multiplicand[0][3];
+  const f32 multiplicand_1_0 = multiplicand[1][0];
+  const f32 multiplicand_1_1 = multiplicand[1][1];
+  const f32 multiplicand_1_2 = multiplicand[1][2];
+  const f32 multiplicand_1_3 = multiplicand[1][3];
+  const f32 multiplicand_2_0 = multiplicand[2][0];
+  const f32 multiplicand_2_1 = multiplicand[2][1];
+  const f32 multiplicand_2_2 = multiplicand[2][2];
+  const f32 multiplicand_2_3 = multiplicand[2][3];
+
+  product[0][0] = multiplicand_0_0 * multiplier_0_0 + multiplicand_1_0 * multiplier_0_1 + multiplicand_2_0 * multiplier_0_2;
+  product[0][1] = multiplicand_0_1 * multiplier_0_0 + multiplicand_1_1 * multiplier_0_1 + multiplicand_2_1 * multiplier_0_2;
+  product[0][2] = multiplicand_0_2 * multiplier_0_0 + multiplicand_1_2 * multiplier_0_1 + multiplicand_2_2 * multiplier_0_2;
+  product[0][3] = multiplicand_0_3 * multiplier_0_0 + multiplicand_1_3 * multiplier_0_1 + multiplicand_2_3 * multiplier_0_2 + multiplier_0_3;
+  product[1][0] = multiplicand_0_0 * multiplier_1_0 + multiplicand_1_0 * multiplier_1_1 + multiplicand_2_0 * multiplier_1_2;
+  product[1][1] = multiplicand_0_1 * multiplier_1_0 + multiplicand_1_1 * multiplier_1_1 + multiplicand_2_1 * multiplier_1_2;
+  product[1][2] = multiplicand_0_2 * multiplier_1_0 + multiplicand_1_2 * multiplier_1_1 + multiplicand_2_2 * multiplier_1_2;
+  product[1][3] = multiplicand_0_3 * multiplier_1_0 + multiplicand_1_3 * multiplier_1_1 + multiplicand_2_3 * multiplier_1_2 + multiplier_1_3;
+  product[2][0] = multiplicand_0_0 * multiplier_2_0 + multiplicand_1_0 * multiplier_2_1 + multiplicand_2_0 * multiplier_2_2;
+  product[2][1] = multiplicand_0_1 * multiplier_2_0 + multiplicand_1_1 * multiplier_2_1 + multiplicand_2_1 * multiplier_2_2;
+  product[2][2] = multiplicand_0_2 * multiplier_2_0 + multiplicand_1_2 * multiplier_2_1 + multiplicand_2_2 * multiplier_2_2;
+  product[2][3] = multiplicand_0_3 * multiplier_2_0 + multiplicand_1_3 * multiplier_2_1 + multiplicand_2_3 * multiplier_2_2 + multiplier_2_3;
+#endif
+
+  product[3][0] = 0;
+  product[3][1] = 0;
+  product[3][2] = 0;
+  product[3][3] = 1;
 }
 
 void perspective(
@@ -199,9 +385,6 @@ void model(
     matrix forward,
     matrix inverse)
 {
-  const f32 scale_x_reciprocal = 1 / scale[0];
-  const f32 scale_y_reciprocal = 1 / scale[1];
-  const f32 scale_z_reciprocal = 1 / scale[2];
   const f32 sin_x = sine(rotation[0]);
   const f32 cos_x = cosine(rotation[0]);
   const f32 sin_y = sine(rotation[1]);
@@ -217,15 +400,6 @@ void model(
   const f32 g = d * sin_y;
   const f32 h = sin_x * sin_y;
   const f32 i = cos_x * sin_y;
-  const f32 xx = cos_y * cos_z * scale_x_reciprocal;
-  const f32 xy = cos_y * sin_z * scale_x_reciprocal;
-  const f32 xz = -sin_y * scale_x_reciprocal;
-  const f32 yx = (h * cos_z - cos_x * sin_z) * scale_y_reciprocal;
-  const f32 yy = (cos_x * cos_z + h * sin_z) * scale_y_reciprocal;
-  const f32 yz = sin_x * cos_y * scale_y_reciprocal;
-  const f32 zx = (i * cos_z + sin_x * sin_z) * scale_z_reciprocal;
-  const f32 zy = (-sin_x * cos_z + i * sin_z) * scale_z_reciprocal;
-  const f32 zz = cos_x * cos_y * scale_z_reciprocal;
   forward[0][0] = e * cos_z;
   forward[0][1] = f * cos_z - a * sin_z;
   forward[0][2] = g * cos_z - b * sin_z;
@@ -242,22 +416,154 @@ void model(
   forward[3][1] = 0;
   forward[3][2] = 0;
   forward[3][3] = 1;
-  inverse[0][0] = xx;
-  inverse[0][1] = xy;
-  inverse[0][2] = xz;
-  inverse[0][3] = -(location[0] * xx + location[1] * xy + location[2] * xz);
-  inverse[1][0] = yx;
-  inverse[1][1] = yy;
-  inverse[1][2] = yz;
-  inverse[1][3] = -(location[0] * yx + location[1] * yy + location[2] * yz);
-  inverse[2][0] = zx;
-  inverse[2][1] = zy;
-  inverse[2][2] = zz;
-  inverse[2][3] = -(location[0] * zx + location[1] * zy + location[2] * zz);
-  inverse[3][0] = 0;
-  inverse[3][1] = 0;
-  inverse[3][2] = 0;
-  inverse[3][3] = 1;
+
+  if (inverse != NULL)
+  {
+    const f32 scale_x_reciprocal = 1 / scale[0];
+    const f32 scale_y_reciprocal = 1 / scale[1];
+    const f32 scale_z_reciprocal = 1 / scale[2];
+    const f32 xx = cos_y * cos_z * scale_x_reciprocal;
+    const f32 xy = cos_y * sin_z * scale_x_reciprocal;
+    const f32 xz = -sin_y * scale_x_reciprocal;
+    const f32 yx = (h * cos_z - cos_x * sin_z) * scale_y_reciprocal;
+    const f32 yy = (cos_x * cos_z + h * sin_z) * scale_y_reciprocal;
+    const f32 yz = sin_x * cos_y * scale_y_reciprocal;
+    const f32 zx = (i * cos_z + sin_x * sin_z) * scale_z_reciprocal;
+    const f32 zy = (-sin_x * cos_z + i * sin_z) * scale_z_reciprocal;
+    const f32 zz = cos_x * cos_y * scale_z_reciprocal;
+    inverse[0][0] = xx;
+    inverse[0][1] = xy;
+    inverse[0][2] = xz;
+    inverse[0][3] = -(location[0] * xx + location[1] * xy + location[2] * xz);
+    inverse[1][0] = yx;
+    inverse[1][1] = yy;
+    inverse[1][2] = yz;
+    inverse[1][3] = -(location[0] * yx + location[1] * yy + location[2] * yz);
+    inverse[2][0] = zx;
+    inverse[2][1] = zy;
+    inverse[2][2] = zz;
+    inverse[2][3] = -(location[0] * zx + location[1] * zy + location[2] * zz);
+    inverse[3][0] = 0;
+    inverse[3][1] = 0;
+    inverse[3][2] = 0;
+    inverse[3][3] = 1;
+  }
+}
+
+// Trigonometry for this many models is calculated at a time, bounding the stack
+// space used by models.
+#define MODELS_PER_BATCH 32
+
+void models(
+    const vector *const locations,
+    const vector *const rotations,
+    const vector *const scales,
+    matrix *const forwards,
+    const quantity quantity)
+{
+  f32 sines[MODELS_PER_BATCH][VECTOR_COMPONENTS];
+  f32 cosines[MODELS_PER_BATCH][VECTOR_COMPONENTS];
+
+  for (index batch_start = 0; batch_start < quantity; batch_start += MODELS_PER_BATCH)
+  {
+    const index remaining = quantity - batch_start;
+    const index batch_size = remaining < MODELS_PER_BATCH ? remaining : MODELS_PER_BATCH;
+
+    sines_and_cosines(rotations[batch_start], sines[0], cosines[0], batch_size * VECTOR_COMPONENTS);
+
+    for (index offset = 0; offset < batch_size; offset++)
+    {
+      const f32 *const location = locations[batch_start + offset];
+      const f32 *const scale = scales[batch_start + offset];
+      f32(*const forward)[MATRIX_COLUMNS] = forwards[batch_start + offset];
+      const f32 sin_x = sines[offset][0];
+      const f32 cos_x = cosines[offset][0];
+      const f32 sin_y = sines[offset][1];
+      const f32 cos_y = cosines[offset][1];
+      const f32 sin_z = sines[offset][2];
+      const f32 cos_z = cosines[offset][2];
+      const f32 a = scale[1] * cos_x;
+      const f32 b = -scale[2] * sin_x;
+      const f32 c = scale[1] * sin_x;
+      const f32 d = scale[2] * cos_x;
+      const f32 e = scale[0] * cos_y;
+      const f32 f = c * sin_y;
+      const f32 g = d * sin_y;
+      forward[0][0] = e * cos_z;
+      forward[0][1] = f * cos_z - a * sin_z;
+      forward[0][2] = g * cos_z - b * sin_z;
+      forward[0][3] = location[0];
+      forward[1][0] = e * sin_z;
+      forward[1][1] = a * cos_z + f * sin_z;
+      forward[1][2] = b * cos_z + g * sin_z;
+      forward[1][3] = location[1];
+      forward[2][0] = -scale[0] * sin_y;
+      forward[2][1] = c * cos_y;
+      forward[2][2] = d * cos_y;
+      forward[2][3] = location[2];
+      forward[3][0] = 0;
+      forward[3][1] = 0;
+      forward[3][2] = 0;
+      forward[3][3] = 1;
+    }
+  }
+}
+
+void invert_affine_matrix(
+    const matrix forward,
+    matrix inverse)
+{
+  const f32 forward_0_0 = forward[0][0];
+  const f32 forward_0_1 = forward[0][1];
+  const f32 forward_0_2 = forward[0][2];
+  const f32 forward_0_3 = forward[0][3];
+  const f32 forward_1_0 = forward[1][0];
+  const f32 forward_1_1 = forward[1][1];
+  const f32 forward_1_2 = forward[1][2];
+  const f32 forward_1_3 = forward[1][3];
+  const f32 forward_2_0 = forward[2][0];
+  const f32 forward_2_1 = forward[2][1];
+  const f32 forward_2_2 = forward[2][2];
+  const f32 forward_2_3 = forward[2][3];
+
+  const f32 cofactor_0_0 = forward_1_1 * forward_2_2 - forward_1_2 * forward_2_1;
+  const f32 cofactor_0_1 = forward_0_2 * forward_2_1 - forward_0_1 * forward_2_2;
+  const f32 cofactor_0_2 = forward_0_1 * forward_1_2 - forward_0_2 * forward_1_1;
+  const f32 cofactor_1_0 = forward_1_2 * forward_2_0 - forward_1_0 * forward_2_2;
+  const f32 cofactor_1_1 = forward_0_0 * forward_2_2 - forward_0_2 * forward_2_0;
+  const f32 cofactor_1_2 = forward_0_2 * forward_1_0 - forward_0_0 * forward_1_2;
+  const f32 cofactor_2_0 = forward_1_0 * forward_2_1 - forward_1_1 * forward_2_0;
+  const f32 cofactor_2_1 = forward_0_1 * forward_2_0 - forward_0_0 * forward_2_1;
+  const f32 cofactor_2_2 = forward_0_0 * forward_1_1 - forward_0_1 * forward_1_0;
+
+  const f32 determinant_reciprocal = 1.0f / (forward_0_0 * cofactor_0_0 + forward_0_1 * cofactor_1_0 + forward_0_2 * cofactor_2_0);
+
+  const f32 inverse_0_0 = cofactor_0_0 * determinant_reciprocal;
+  const f32 inverse_0_1 = cofactor_0_1 * determinant_reciprocal;
+  const f32 inverse_0_2 = cofactor_0_2 * determinant_reciprocal;
+  const f32 inverse_1_0 = cofactor_1_0 * determinant_reciprocal;
+  const f32 inverse_1_1 = cofactor_1_1 * determinant_reciprocal;
+  const f32 inverse_1_2 = cofactor_1_2 * determinant_reciprocal;
+  const f32 inverse_2_0 = cofactor_2_0 * determinant_reciprocal;
+  const f32 inverse_2_1 = cofactor_2_1 * determinant_reciprocal;
+  const f32 inverse_2_2 = cofactor_2_2 * determinant_reciprocal;
+
+  inverse[0][0] = inverse_0_0;
+  inverse[0][1] = inverse_0_1;
+  inverse[0][2] = inverse_0_2;
+  inverse[0][3] = -(inverse_0_0 * forward_0_3 + inverse_0_1 * forward_1_3 + inverse_0_2 * forward_2_3);
+  inverse[1][0] = inverse_1_0;
+  inverse[1][1] = inverse_1_1;
+  inverse[1][2] = inverse_1_2;
+  inverse[1][3] = -(inverse_1_0 * forward_0_3 + inverse_1_1 * forward_1_3 + inverse_1_2 * forward_2_3);
+  inverse[2][0] = inverse_2_0;
+  inverse[2][1] = inverse_2_1;
+  inverse[2][2] = inverse_2_2;
+  inverse[2][3] = -(inverse_2_0 * forward_0_3 + inverse_2_1 * forward_1_3 + inverse_2_2 * forward_2_3);
+  inverse[3][0] = 0.0f;
+  inverse[3][1] = 0.0f;
+  inverse[3][2] = 0.0f;
+  inverse[3][3] = 1.0f;
 }
 
 void copy_matrix(
@@ -7,6 +7,7 @@
 #include "../primitives/f32.h"
 #include "culled_by.h"
 #include "vector.h"
+#include "../primitives/quantity.h"
 
 /**
  * The number of rows in a matrix.
@@ -74,6 +75,36 @@ void multiply_matrices(
     const matrix multiplicand,
     matrix product);
 
+/**
+ * Calculates the product of a matrix and an affine matrix, such as a projection
+ * and a model matrix.  Equivalent to @ref multiply_matrices, but skips the
+ * known bottom row of the multiplicand.
+ * @remark The bottom row of "multiplicand" is assumed to be 0, 0, 0, 1.
+ * @param multiplier The first matrix to multiply.
+ * @param multiplicand The second matrix to multiply, which must be affine.
+ * @param product The matrix to which to write the result.  May be "multiplier",
+ *                "multiplicand" or both.
+ */
+void multiply_matrix_by_affine_matrix(
+    const matrix multiplier,
+    const matrix multiplicand,
+    matrix product);
+
+/**
+ * Calculates the product of two affine matrices, such as two model matrices.
+ * Equivalent to @ref multiply_matrices, but skips the known bottom rows.
+ * @remark The bottom rows of "multiplier" and "multiplicand" are assumed to be
+ *         0, 0, 0, 1.
+ * @param multiplier The first matrix to multiply, which must be affine.
+ * @param multiplicand The second matrix to multiply, which must be affine.
+ * @param product The matrix to which to write the result.  May be "multiplier",
+ *                "multiplicand" or both.
+ */
+void multiply_affine_matrices(
+    const matrix multiplier,
+    const matrix multiplicand,
+    matrix product);
+
 /**
  * Calculates a projection matrix for a perspective camera similar to that which
  * would be generated by Blender, and its inverse.  It may differ slightly from
@@ -111,7 +142,8 @@ void perspective(
  * @param rotation The rotation around each axis, in radians.
  * @param scale The scale of the object on each axis, as multiplying factors.
  * @param forward The matrix to which to write the result.
- * @param inverse The matrix to which to write the inverse of result.
+ * @param inverse The matrix to which to write the inverse of result, or NULL
+ *                should it not be required.
  */
 void model(
     const vector location,
@@ -120,6 +152,35 @@ void model(
     matrix forward,
     matrix inverse);
 
+/**
+ * Calculates a series of model matrices, equivalent to calling @ref model for
+ * each without an inverse, but sharing trigonometry work between them.
+ * @param locations The locations of the objects in world space.
+ * @param rotations The rotations of the objects around each axis, in radians.
+ * @param scales The scales of the objects on each axis, as multiplying
+ *               factors.
+ * @param forwards The matrices to which to write the results.
+ * @param quantity The number of matrices to calculate.
+ */
+void models(
+    const vector *const locations,
+    const vector *const rotations,
+    const vector *const scales,
+    matrix *const forwards,
+    const quantity quantity);
+
+/**
+ * Calculates the inverse of an affine matrix, such as one produced by
+ * @ref model or the product of several.
+ * @remark The bottom row is assumed to be 0, 0, 0, 1.
+ * @param forward The matrix to invert.
+ * @param inverse The matrix to which to write the inverse of "forward".  May be
+ *                "forward".
+ */
+void invert_affine_matrix(
+    const matrix forward,
+    matrix inverse);
+
 /**
  * Copies the content of a matrix into another.
  * @param origin The matrix to copy from.
@@ -330,3 +330,31 @@ f32 cosine(f32 radians)
     return sine_table[rounded - 768];
   }
 }
+
+void sines_and_cosines(
+    const f32 *const radians,
+    f32 *const sines,
+    f32 *const cosines,
+    const quantity quantity)
+{
+  for (index angle = 0; angle < quantity; angle++)
+  {
+    const f32 unrounded = radians[angle] * (1024 / PI);
+    index rounded = unrounded;
+    rounded += rounded <= unrounded;
+    rounded %= 2048;
+    rounded += rounded < 0 ? 2048 : 0;
+    rounded /= 2;
+
+    // Each quarter of the circle reads the table either forward or backward,
+    // and either as-is or negated.
+    const index quarter = rounded >> 8;
+    const index offset = rounded & 255;
+    const index sine_offset = quarter & 1 ? 256 - offset : offset;
+    const f32 sine_sign = quarter & 2 ? -1.0f : 1.0f;
+    const f32 cosine_sign = (quarter ^ (quarter >> 1)) & 1 ? -1.0f : 1.0f;
+
+    sines[angle] = sine_sign * sine_table[sine_offset];
+    cosines[angle] = cosine_sign * sine_table[256 - sine_offset];
+  }
+}
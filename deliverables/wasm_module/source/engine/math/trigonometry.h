@@ -5,6 +5,7 @@
 #define TRIGONOMETRY_H
 
 #include "../primitives/f32.h"
+#include "../primitives/quantity.h"
 
 /**
  * The value of PI.
@@ -25,4 +26,19 @@ f32 sine(f32 radians);
  */
 f32 cosine(f32 radians);
 
+/**
+ * Calculates the sines and cosines of a series of angles.  Equivalent to
+ * calling @ref sine and @ref cosine for each, but without branching, so that
+ * the compiler may vectorize it.
+ * @param radians The angles to calculate the sines and cosines of, in radians.
+ * @param sines The f32s to which to write the sines of the given angles.
+ * @param cosines The f32s to which to write the cosines of the given angles.
+ * @param quantity The number of angles.
+ */
+void sines_and_cosines(
+    const f32 *const radians,
+    f32 *const sines,
+    f32 *const cosines,
+    const quantity quantity);
+
 #endif
@@ -27,14 +27,21 @@ typedef s32 index;
 #define INDEX_NONE -1
 
 /**
- * Finds an vacant slot within a field of indices.  Attempts to maintain as
- * small and contiguous a range of used indices as possible.
- * @param vacancies An array which can be used to check for occupancy.
- * @param vacant A constant which indicates a vacancy in the array of potential
- *               vacancies.
+ * Allocates a vacant slot from a pool in constant time.  The pool is tracked
+ * using an array of occupied slots, of which the first "total_occupied" are in
+ * use (in no particular order) and the remainder up to "total_initialized"
+ * form a free list of previously released slots.
+ * @param occupied The name of the array of slot indices, ordered occupied
+ *                 first, then vacant.  This needs no initialization.
+ * @param positions The name of the array mapping each slot index to its
+ *                  position within the array of occupied slots.  This needs no
+ *                  initialization.
  * @param count The number of slots.
+ * @param total_initialized The name of the previously defined variable
+ *                          containing the number of slots which have ever been
+ *                          occupied.  This must initially be 0.
  * @param first_occupied The name of the previously defined variable containing
- *                       the index of the first occupied slot.  This must be
+ *                       the index of the first occupied slot.  This is
  *                       INDEX_NONE if no slots are occupied.
  * @param last_occupied The name of the previously defined variable containing
  *                      the index of the last occupied slot.
@@ -44,107 +51,90 @@ typedef s32 index;
  * @param output The name of the variable to declare and populate with the index
  *               of the vacant slot.
  */
-#define FIND_EMPTY_INDEX(vacancies, vacant, count, first_occupied, last_occupied, total_occupied, error, output) \
-  index output;                                                                                                  \
-                                                                                                                 \
-  if (total_occupied == 0)                                                                                       \
-  {                                                                                                              \
-    output = 0;                                                                                                  \
-    first_occupied = 0;                                                                                          \
-    last_occupied = 0;                                                                                           \
-    total_occupied = 1;                                                                                          \
-  }                                                                                                              \
-  else if (total_occupied == (1 + last_occupied - first_occupied))                                               \
-  {                                                                                                              \
-    if (first_occupied > 0)                                                                                      \
-    {                                                                                                            \
-      total_occupied++;                                                                                          \
-      first_occupied--;                                                                                          \
-      output = first_occupied;                                                                                   \
-    }                                                                                                            \
-    else if (last_occupied < (count)-1)                                                                          \
-    {                                                                                                            \
-      total_occupied++;                                                                                          \
-      last_occupied++;                                                                                           \
-      output = last_occupied;                                                                                    \
-    }                                                                                                            \
-    else                                                                                                         \
-    {                                                                                                            \
-      throw(error);                                                                                              \
-    }                                                                                                            \
-  }                                                                                                              \
-  else                                                                                                           \
-  {                                                                                                              \
-    for (output = first_occupied; output < last_occupied; output++)                                              \
-    {                                                                                                            \
-      if (vacancies[output] == vacant)                                                                           \
-      {                                                                                                          \
-        total_occupied++;                                                                                        \
-        break;                                                                                                   \
-      }                                                                                                          \
-    }                                                                                                            \
-                                                                                                                 \
-    if (output == last_occupied)                                                                                 \
-    {                                                                                                            \
-      output++;                                                                                                  \
-                                                                                                                 \
-      if (output == count)                                                                                       \
-      {                                                                                                          \
-        if (first_occupied == 0)                                                                                 \
-        {                                                                                                        \
-          throw(error);                                                                                          \
-        }                                                                                                        \
-        else                                                                                                     \
-        {                                                                                                        \
-          total_occupied++;                                                                                      \
-          output = first_occupied - 1;                                                                           \
-          first_occupied = output;                                                                               \
-        }                                                                                                        \
-      }                                                                                                          \
-      else                                                                                                       \
-      {                                                                                                          \
-        total_occupied++;                                                                                        \
-        last_occupied = output;                                                                                  \
-      }                                                                                                          \
-    }                                                                                                            \
-  }
+#define INDEX_ALLOCATE(occupied, positions, count, total_initialized, first_occupied, last_occupied, total_occupied, error, output) \
+  index output;                                                                                                                     \
+                                                                                                                                    \
+  if (total_occupied < total_initialized)                                                                                           \
+  {                                                                                                                                 \
+    output = occupied[total_occupied];                                                                                              \
+  }                                                                                                                                 \
+  else if (total_initialized < (count))                                                                                             \
+  {                                                                                                                                 \
+    output = total_initialized;                                                                                                     \
+    occupied[total_occupied] = output;                                                                                              \
+    positions[output] = total_occupied;                                                                                             \
+    total_initialized++;                                                                                                            \
+  }                                                                                                                                 \
+  else                                                                                                                              \
+  {                                                                                                                                 \
+    throw(error);                                                                                                                   \
+  }                                                                                                                                 \
+                                                                                                                                    \
+  if (total_occupied == 0)                                                                                                          \
+  {                                                                                                                                 \
+    first_occupied = output;                                                                                                        \
+    last_occupied = output;                                                                                                         \
+  }                                                                                                                                 \
+  else if (output < first_occupied)                                                                                                 \
+  {                                                                                                                                 \
+    first_occupied = output;                                                                                                        \
+  }                                                                                                                                 \
+  else if (output > last_occupied)                                                                                                  \
+  {                                                                                                                                 \
+    last_occupied = output;                                                                                                         \
+  }                                                                                                                                 \
+                                                                                                                                    \
+  total_occupied++;
 
 /**
- * Vacates a slot then maintains look-up state.
- * @param vacated The index of the newly vacated slot.
- * @param vacancies An array which can be used to check for occupancy.
- * @param vacant A constant which indicates a vacancy in the array of potential
- *               vacancies.
+ * Releases a slot previously allocated using @ref INDEX_ALLOCATE in constant
+ * time, save for narrowing the occupied range when its first or last slot is
+ * released.
+ * @remark The last slot in the array of occupied slots is moved to the position
+ *         of the released slot, so iterate over that array in reverse if
+ *         slots may be released during iteration.
+ * @param released The index of the slot to release.
+ * @param occupied The name of the array of slot indices, ordered occupied
+ *                 first, then vacant.
+ * @param positions The name of the array mapping each slot index to its
+ *                  position within the array of occupied slots.
  * @param first_occupied The name of the previously defined variable containing
- *                       the index of the first occupied slot.  This must be
+ *                       the index of the first occupied slot.  This is
  *                       INDEX_NONE if no slots are occupied.
  * @param last_occupied The name of the previously defined variable containing
  *                      the index of the last occupied slot.
  * @param total_occupied The name of the previously defined variable containing
  *                       the total number of occupied slots.
  */
-#define INDEX_VACATE(vacated, vacancies, vacant, first_occupied, last_occupied, total_occupied) \
-  total_occupied--;                                                                             \
-  vacancies[vacated] = vacant;                                                                  \
-                                                                                                \
-  if (vacated == first_occupied)                                                                \
-  {                                                                                             \
-    if (vacated == last_occupied)                                                               \
-    {                                                                                           \
-      first_occupied = INDEX_NONE;                                                              \
-    }                                                                                           \
-    else                                                                                        \
-      do                                                                                        \
-      {                                                                                         \
-        first_occupied++;                                                                       \
-      } while (vacancies[first_occupied] == vacant);                                            \
-  }                                                                                             \
-  else if (vacated == last_occupied)                                                            \
-  {                                                                                             \
-    do                                                                                          \
-    {                                                                                           \
-      last_occupied--;                                                                          \
-    } while (vacancies[last_occupied] == vacant);                                               \
+#define INDEX_RELEASE(released, occupied, positions, first_occupied, last_occupied, total_occupied) \
+  {                                                                                                 \
+    const index released_slot = released;                                                           \
+    const index released_position = positions[released_slot];                                       \
+    total_occupied--;                                                                               \
+    const index moved_slot = occupied[total_occupied];                                              \
+    occupied[released_position] = moved_slot;                                                       \
+    positions[moved_slot] = released_position;                                                      \
+    occupied[total_occupied] = released_slot;                                                       \
+    positions[released_slot] = total_occupied;                                                      \
+                                                                                                    \
+    if (total_occupied == 0)                                                                        \
+    {                                                                                               \
+      first_occupied = INDEX_NONE;                                                                  \
+    }                                                                                               \
+    else if (released_slot == first_occupied)                                                       \
+    {                                                                                               \
+      do                                                                                            \
+      {                                                                                             \
+        first_occupied++;                                                                           \
+      } while (positions[first_occupied] >= total_occupied);                                        \
+    }                                                                                               \
+    else if (released_slot == last_occupied)                                                        \
+    {                                                                                               \
+      do                                                                                            \
+      {                                                                                             \
+        last_occupied--;                                                                            \
+      } while (positions[last_occupied] >= total_occupied);                                         \
+    }                                                                                               \
   }
 
 #endif
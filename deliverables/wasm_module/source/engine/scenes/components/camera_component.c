@@ -1,6 +1,7 @@
 #include "../entity.h"
 #include "component.h"
 #include "../../primitives/f32.h"
+#include "../../primitives/s32.h"
 #include "../../primitives/quantity.h"
 #include "../../primitives/index.h"
 #include "../../../game/project_settings/limits.h"
@@ -10,6 +11,9 @@
 #include "../../exports/buffers/video.h"
 #include "../../math/relational.h"
 #include "../../math/matrix.h"
+#include "../../assets/render_texture.h"
+#include "../snapshot.h"
+#include "selectable_component.h"
 
 f32 previous_camera_component_sensor_sizes[MAXIMUM_CAMERA_COMPONENTS];
 f32 next_camera_component_sensor_sizes[MAXIMUM_CAMERA_COMPONENTS];
@@ -29,12 +33,36 @@ f32 previous_camera_component_lefts[MAXIMUM_CAMERA_COMPONENTS];
 f32 next_camera_component_lefts[MAXIMUM_CAMERA_COMPONENTS];
 f32 previous_camera_component_rights[MAXIMUM_CAMERA_COMPONENTS];
 f32 next_camera_component_rights[MAXIMUM_CAMERA_COMPONENTS];
+render_texture *camera_component_render_textures[MAXIMUM_CAMERA_COMPONENTS];
+s32 camera_component_culling_masks[MAXIMUM_CAMERA_COMPONENTS];
 
-static index first_occupied;
+static index occupied[MAXIMUM_CAMERA_COMPONENTS];
+static index positions[MAXIMUM_CAMERA_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
 static index last_occupied;
 static quantity total_occupied;
 static const matrix *transforms[MAXIMUM_CAMERA_COMPONENTS];
+static index entities[MAXIMUM_CAMERA_COMPONENTS];
 static const matrix *inverse_transforms[MAXIMUM_CAMERA_COMPONENTS];
+static f32 sensor_sizes[MAXIMUM_CAMERA_COMPONENTS];
+static f32 near_clip_distances[MAXIMUM_CAMERA_COMPONENTS];
+static f32 far_clip_distances[MAXIMUM_CAMERA_COMPONENTS];
+static f32 focal_lengths[MAXIMUM_CAMERA_COMPONENTS];
+static f32 tops[MAXIMUM_CAMERA_COMPONENTS];
+static f32 bottoms[MAXIMUM_CAMERA_COMPONENTS];
+static f32 lefts[MAXIMUM_CAMERA_COMPONENTS];
+static f32 rights[MAXIMUM_CAMERA_COMPONENTS];
+static s32 changed[MAXIMUM_CAMERA_COMPONENTS];
+static s32 stale[MAXIMUM_CAMERA_COMPONENTS];
+static render_texture *rendered_render_textures[MAXIMUM_CAMERA_COMPONENTS];
+static s32 rendered_culling_masks[MAXIMUM_CAMERA_COMPONENTS];
+static matrix rendered_transforms[MAXIMUM_CAMERA_COMPONENTS];
+static matrix rendered_inverse_transforms[MAXIMUM_CAMERA_COMPONENTS];
+
+// The rectangle of the video buffer written to by each camera component during
+// the previous render, in the same format as video_dirty_rectangles.
+static s32 rendered_dirty_rectangles[MAXIMUM_CAMERA_COMPONENTS * 4];
 
 matrix camera_component_view_projection;
 matrix camera_component_inverse_view_projection;
@@ -50,13 +78,30 @@ f32 camera_component_clip_to_video_row_offset;
 f32 camera_component_clip_to_video_column_coefficient;
 f32 camera_component_clip_to_video_column_offset;
 f32 camera_component_gain;
+s32 camera_component_culling_mask;
+s32 camera_component_dirty_top;
+s32 camera_component_dirty_left;
+s32 camera_component_dirty_bottom;
+s32 camera_component_dirty_right;
+s32 camera_component_picking_row;
+s32 camera_component_picking_column;
+
+void reserve_camera_components(const quantity quantity)
+{
+  if (quantity > MAXIMUM_CAMERA_COMPONENTS - total_occupied)
+  {
+    throw(ERROR_NO_CAMERA_COMPONENTS_TO_ALLOCATE);
+  }
+}
 
 static index allocate(index entity)
 {
-  FIND_EMPTY_INDEX(transforms, NULL, MAXIMUM_CAMERA_COMPONENTS, first_occupied, last_occupied, total_occupied, ERROR_NO_CAMERA_COMPONENTS_TO_ALLOCATE, camera)
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_CAMERA_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_CAMERA_COMPONENTS_TO_ALLOCATE, camera)
 
   transforms[camera] = &interpolated_entity_transforms[entity];
   inverse_transforms[camera] = &interpolated_inverse_entity_transforms[entity];
+  entities[camera] = entity;
+  reference_inverse_entity_transform(entity);
   previous_camera_component_sensor_sizes[camera] = 36;
   next_camera_component_sensor_sizes[camera] = 36;
   previous_camera_component_near_clip_distances[camera] = 0.1;
@@ -73,6 +118,8 @@ static index allocate(index entity)
   next_camera_component_bottoms[camera] = -1;
   previous_camera_component_tops[camera] = 1;
   next_camera_component_tops[camera] = 1;
+  camera_component_render_textures[camera] = NULL;
+  camera_component_culling_masks[camera] = -1;
 
   return camera;
 }
@@ -81,6 +128,8 @@ static void destroy(const component_handle component)
 {
   const index camera = COMPONENT_HANDLE_META(component);
   transforms[camera] = NULL;
+  dereference_inverse_entity_transform(entities[camera]);
+  INDEX_RELEASE(camera, occupied, positions, first_occupied, last_occupied, total_occupied)
 }
 
 component_handle camera_component(
@@ -97,82 +146,393 @@ component_handle camera_sub_component(
   return sub_component(component, camera, destroy);
 }
 
-void render_camera_components(render_camera_component *const on_render)
+static void prepare_camera_component_column_for_video(
+    const f32 *const previous,
+    const f32 *const next,
+    f32 *const interpolated,
+    s32 *const changed,
+    const quantity total)
+{
+  for (index index = 0; index < total; index++)
+  {
+    const f32 value = tick_progress * next[index] + inverse_tick_progress * previous[index];
+    changed[index] |= value != interpolated[index];
+    interpolated[index] = value;
+  }
+}
+
+static s32 prepare_camera_component_transform_for_video(
+    const matrix source,
+    matrix destination)
+{
+  const f32 *const source_f32s = &source[0][0];
+  f32 *const destination_f32s = &destination[0][0];
+  s32 changed = 0;
+
+  for (index index = 0; index < 16; index++)
+  {
+    const f32 value = source_f32s[index];
+    changed |= value != destination_f32s[index];
+    destination_f32s[index] = value;
+  }
+
+  return changed;
+}
+
+s32 prepare_camera_components_for_video(const s32 changed_layers)
 {
+  s32 any_changed = 0;
+
   if (first_occupied != INDEX_NONE)
   {
-    const f32 clip_to_video_row_offset = ((f32)video_rows) / 2.0f;
-    const f32 clip_to_video_row_coefficient = -clip_to_video_row_offset;
+    const quantity total = 1 + last_occupied - first_occupied;
 
-    const f32 clip_to_video_column_offset = ((f32)video_columns) / 2.0f;
-    const f32 clip_to_video_column_coefficient = clip_to_video_column_offset;
+    for (index camera = first_occupied; camera <= last_occupied; camera++)
+    {
+      changed[camera] = 0;
+    }
+
+    prepare_camera_component_column_for_video(&previous_camera_component_sensor_sizes[first_occupied], &next_camera_component_sensor_sizes[first_occupied], &sensor_sizes[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_near_clip_distances[first_occupied], &next_camera_component_near_clip_distances[first_occupied], &near_clip_distances[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_far_clip_distances[first_occupied], &next_camera_component_far_clip_distances[first_occupied], &far_clip_distances[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_focal_lengths[first_occupied], &next_camera_component_focal_lengths[first_occupied], &focal_lengths[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_tops[first_occupied], &next_camera_component_tops[first_occupied], &tops[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_bottoms[first_occupied], &next_camera_component_bottoms[first_occupied], &bottoms[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_lefts[first_occupied], &next_camera_component_lefts[first_occupied], &lefts[first_occupied], &changed[first_occupied], total);
+    prepare_camera_component_column_for_video(&previous_camera_component_rights[first_occupied], &next_camera_component_rights[first_occupied], &rights[first_occupied], &changed[first_occupied], total);
 
     for (index camera = first_occupied; camera <= last_occupied; camera++)
     {
-      const matrix *const transform = transforms[camera];
+      if (transforms[camera] != NULL)
+      {
+        render_texture *const target = camera_component_render_textures[camera];
+
+        if (target != rendered_render_textures[camera])
+        {
+          rendered_render_textures[camera] = target;
+          changed[camera] = 1;
+        }
+
+        const s32 culling_mask = camera_component_culling_masks[camera];
+
+        if (culling_mask != rendered_culling_masks[camera])
+        {
+          rendered_culling_masks[camera] = culling_mask;
+          changed[camera] = 1;
+        }
+
+        changed[camera] |= prepare_camera_component_transform_for_video(*transforms[camera], rendered_transforms[camera]);
+        changed[camera] |= prepare_camera_component_transform_for_video(*inverse_transforms[camera], rendered_inverse_transforms[camera]);
+
+        stale[camera] |= (changed_layers & culling_mask) || changed[camera];
+        any_changed |= changed[camera];
+      }
+    }
+  }
+
+  return any_changed;
+}
+
+void mark_camera_component_dirty(
+    const s32 top,
+    const s32 left,
+    const s32 bottom,
+    const s32 right)
+{
+  const s32 clamped_top = MAX(top, 0);
+  const s32 clamped_left = MAX(left, 0);
+  const s32 clamped_bottom = MIN(bottom, (s32)camera_component_rows);
+  const s32 clamped_right = MIN(right, (s32)camera_component_columns);
+
+  if (clamped_top < clamped_bottom && clamped_left < clamped_right)
+  {
+    camera_component_dirty_top = MIN(camera_component_dirty_top, clamped_top);
+    camera_component_dirty_left = MIN(camera_component_dirty_left, clamped_left);
+    camera_component_dirty_bottom = MAX(camera_component_dirty_bottom, clamped_bottom);
+    camera_component_dirty_right = MAX(camera_component_dirty_right, clamped_right);
+  }
+}
+
+static void render_camera_component_into(
+    const index camera,
+    render_texture *const target,
+    render_camera_component *const on_render)
+{
+  quantity target_rows, target_columns;
+  f32 *target_reds, *target_greens, *target_blues, *target_opacities, *target_depths;
+
+  if (target == NULL)
+  {
+    target_rows = video_rows;
+    target_columns = video_columns;
+    target_reds = video_reds;
+    target_greens = video_greens;
+    target_blues = video_blues;
+    target_opacities = video_opacities;
+    target_depths = video_depths;
+  }
+  else
+  {
+    target_rows = target->sampled.rows;
+    target_columns = target->sampled.columns;
+    target_reds = target->reds;
+    target_greens = target->greens;
+    target_blues = target->blues;
+    target_opacities = target->opacities;
+    target_depths = target->depths;
+  }
+
+  const f32 clip_to_target_row_offset = ((f32)target_rows) / 2.0f;
+  const f32 clip_to_target_row_coefficient = -clip_to_target_row_offset;
+
+  const f32 clip_to_target_column_offset = ((f32)target_columns) / 2.0f;
+  const f32 clip_to_target_column_coefficient = clip_to_target_column_offset;
+
+  const f32 top = tops[camera];
+  const quantity top_rows = top * clip_to_target_row_coefficient + clip_to_target_row_offset;
+  const quantity top_rows_clamped = CLAMP(top_rows, 0, target_rows);
+
+  const f32 bottom = bottoms[camera];
+  const quantity bottom_rows = bottom * clip_to_target_row_coefficient + clip_to_target_row_offset;
+  const quantity bottom_rows_clamped = CLAMP(bottom_rows, 0, target_rows);
+
+  const f32 left = lefts[camera];
+  const quantity left_columns = left * clip_to_target_column_coefficient + clip_to_target_column_offset;
+  const quantity left_columns_clamped = CLAMP(left_columns, 0, target_columns);
+
+  const f32 right = rights[camera];
+  const quantity right_columns = right * clip_to_target_column_coefficient + clip_to_target_column_offset;
+  const quantity right_columns_clamped = CLAMP(right_columns, 0, target_columns);
+
+  if (left_columns_clamped < right_columns_clamped && top_rows_clamped < bottom_rows_clamped)
+  {
+    const index offset = top_rows_clamped * target_columns + left_columns_clamped;
+    camera_component_reds = &target_reds[offset];
+    camera_component_greens = &target_greens[offset];
+    camera_component_blues = &target_blues[offset];
+    camera_component_opacities = &target_opacities[offset];
+    camera_component_depths = &target_depths[offset];
+    camera_component_rows = bottom_rows - top_rows;
+    camera_component_columns = right_columns - left_columns;
+
+    const f32 sensor_size = sensor_sizes[camera];
+    const f32 near_clip_distance = near_clip_distances[camera];
+    const f32 far_clip_distance = far_clip_distances[camera];
+    const f32 focal_length = focal_lengths[camera];
+    camera_component_culling_mask = camera_component_culling_masks[camera];
+    camera_component_gain = tick_progress * next_camera_component_gains[camera] + inverse_tick_progress * previous_camera_component_gains[camera];
+
+    camera_component_clip_to_video_row_coefficient = ((f32)top_rows - (f32)bottom_rows) * 0.5f;
+    camera_component_clip_to_video_row_offset = -camera_component_clip_to_video_row_coefficient;
+    camera_component_clip_to_video_column_coefficient = ((f32)right_columns - (f32)left_columns) * 0.5f;
+    camera_component_clip_to_video_column_offset = camera_component_clip_to_video_column_coefficient;
+
+    matrix projection, inverse_projection;
+
+    perspective(
+        right_columns - left_columns,
+        bottom_rows - top_rows,
+        focal_length,
+        0,
+        0,
+        near_clip_distance,
+        far_clip_distance,
+        sensor_size,
+        projection,
+        inverse_projection);
+
+    multiply_matrix_by_affine_matrix(projection, *inverse_transforms[camera], camera_component_view_projection);
+
+    // TODO: check ordering
+    multiply_matrix_by_affine_matrix(inverse_projection, *transforms[camera], camera_component_inverse_view_projection);
+
+    // Picking only applies to what is rendered to the video buffer.
+    const s32 picking_row = selectable_component_picking_row - top_rows_clamped;
+    const s32 picking_column = selectable_component_picking_column - left_columns_clamped;
 
-      if (transform != NULL)
+    if (target == NULL && selectable_component_picking_row != INDEX_NONE && picking_row >= 0 && picking_row < camera_component_rows && picking_column >= 0 && picking_column < camera_component_columns)
+    {
+      camera_component_picking_row = picking_row;
+      camera_component_picking_column = picking_column;
+    }
+    else
+    {
+      camera_component_picking_row = INDEX_NONE;
+      camera_component_picking_column = INDEX_NONE;
+    }
+
+    camera_component_dirty_top = camera_component_rows;
+    camera_component_dirty_left = camera_component_columns;
+    camera_component_dirty_bottom = 0;
+    camera_component_dirty_right = 0;
+
+    on_render();
+
+    if (target == NULL && camera_component_dirty_top < camera_component_dirty_bottom)
+    {
+      const s32 dirty_top = top_rows + camera_component_dirty_top;
+      const s32 dirty_left = left_columns + camera_component_dirty_left;
+      const s32 dirty_bottom = top_rows + camera_component_dirty_bottom;
+      const s32 dirty_right = left_columns + camera_component_dirty_right;
+      const s32 clamped_dirty_top = MAX(dirty_top, 0);
+      const s32 clamped_dirty_left = MAX(dirty_left, 0);
+      const s32 clamped_dirty_bottom = MIN(dirty_bottom, (s32)video_rows);
+      const s32 clamped_dirty_right = MIN(dirty_right, (s32)video_columns);
+
+      if (clamped_dirty_top < clamped_dirty_bottom && clamped_dirty_left < clamped_dirty_right)
       {
-        const f32 top = tick_progress * next_camera_component_tops[camera] + inverse_tick_progress * previous_camera_component_tops[camera];
-        const quantity top_rows = top * clip_to_video_row_coefficient + clip_to_video_row_offset;
-        const quantity top_rows_clamped = CLAMP(top_rows, 0, video_rows);
+        s32 *const rectangle = &video_dirty_rectangles[camera * 4];
+        rectangle[0] = clamped_dirty_top;
+        rectangle[1] = clamped_dirty_left;
+        rectangle[2] = clamped_dirty_bottom - clamped_dirty_top;
+        rectangle[3] = clamped_dirty_right - clamped_dirty_left;
+      }
+    }
+  }
+}
 
-        const f32 bottom = tick_progress * next_camera_component_bottoms[camera] + inverse_tick_progress * previous_camera_component_bottoms[camera];
-        const quantity bottom_rows = bottom * clip_to_video_row_coefficient + clip_to_video_row_offset;
-        const quantity bottom_rows_clamped = CLAMP(bottom_rows, 0, video_rows);
+static s32 render_texture_stale(const render_texture *const target)
+{
+  for (index camera = first_occupied; camera <= last_occupied; camera++)
+  {
+    if (transforms[camera] != NULL && camera_component_render_textures[camera] == target && stale[camera])
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static s32 first_to_render_into(const index camera)
+{
+  const render_texture *const target = camera_component_render_textures[camera];
+
+  for (index other = first_occupied; other < camera; other++)
+  {
+    if (transforms[other] != NULL && camera_component_render_textures[other] == target)
+    {
+      return 0;
+    }
+  }
 
-        const f32 left = tick_progress * next_camera_component_lefts[camera] + inverse_tick_progress * previous_camera_component_lefts[camera];
-        const quantity left_columns = left * clip_to_video_column_coefficient + clip_to_video_column_offset;
-        const quantity left_columns_clamped = CLAMP(left_columns, 0, video_columns);
+  return 1;
+}
 
-        const f32 right = tick_progress * next_camera_component_rights[camera] + inverse_tick_progress * previous_camera_component_rights[camera];
-        const quantity right_columns = right * clip_to_video_column_coefficient + clip_to_video_column_offset;
-        const quantity right_columns_clamped = CLAMP(right_columns, 0, video_columns);
+void render_camera_components(render_camera_component *const on_render)
+{
+  if (first_occupied != INDEX_NONE)
+  {
+    for (index camera = first_occupied; camera <= last_occupied; camera++)
+    {
+      render_texture *const target = camera_component_render_textures[camera];
 
-        if (left_columns_clamped < right_columns_clamped && top_rows_clamped < bottom_rows_clamped)
+      if (transforms[camera] != NULL && target != NULL && render_texture_stale(target))
+      {
+        if (first_to_render_into(camera))
         {
-          const index offset = top_rows_clamped * video_columns + left_columns_clamped;
-          camera_component_reds = &video_reds[offset];
-          camera_component_greens = &video_greens[offset];
-          camera_component_blues = &video_blues[offset];
-          camera_component_opacities = &video_opacities[offset];
-          camera_component_depths = &video_depths[offset];
-          camera_component_rows = bottom_rows - top_rows;
-          camera_component_columns = right_columns - left_columns;
-
-          const f32 sensor_size = tick_progress * next_camera_component_sensor_sizes[camera] + inverse_tick_progress * previous_camera_component_sensor_sizes[camera];
-          const f32 near_clip_distance = tick_progress * next_camera_component_near_clip_distances[camera] + inverse_tick_progress * previous_camera_component_near_clip_distances[camera];
-          const f32 far_clip_distance = tick_progress * next_camera_component_far_clip_distances[camera] + inverse_tick_progress * previous_camera_component_far_clip_distances[camera];
-          const f32 focal_length = tick_progress * next_camera_component_focal_lengths[camera] + inverse_tick_progress * previous_camera_component_focal_lengths[camera];
-          camera_component_gain = tick_progress * next_camera_component_gains[camera] + inverse_tick_progress * previous_camera_component_gains[camera];
-
-          camera_component_clip_to_video_row_coefficient = ((f32)top_rows - (f32)bottom_rows) * 0.5f;
-          camera_component_clip_to_video_row_offset = -camera_component_clip_to_video_row_coefficient;
-          camera_component_clip_to_video_column_coefficient = ((f32)right_columns - (f32)left_columns) * 0.5f;
-          camera_component_clip_to_video_column_offset = camera_component_clip_to_video_column_coefficient;
-
-          matrix projection, inverse_projection;
-
-          perspective(
-              right_columns - left_columns,
-              bottom_rows - top_rows,
-              focal_length,
-              0,
-              0,
-              near_clip_distance,
-              far_clip_distance,
-              sensor_size,
-              projection,
-              inverse_projection);
-
-          multiply_matrices(projection, *inverse_transforms[camera], camera_component_view_projection);
-
-          // TODO: check ordering
-          multiply_matrices(inverse_projection, *transform, camera_component_inverse_view_projection);
-
-          on_render();
+          copy_f32(0.0f, target->opacities, target->sampled.rows * target->sampled.columns);
         }
+
+        render_camera_component_into(camera, target, on_render);
       }
     }
+
+    for (index camera = first_occupied; camera <= last_occupied; camera++)
+    {
+      stale[camera] = 0;
+
+      if (transforms[camera] != NULL && camera_component_render_textures[camera] == NULL)
+      {
+        render_camera_component_into(camera, NULL, on_render);
+      }
+    }
+  }
+
+  // The whole video buffer is cleared before each render, so anything written
+  // by the previous render needs presenting again even when nothing has been
+  // written over it (such as when something has moved away, or its camera
+  // component has been destroyed).
+  for (index camera = 0; camera < MAXIMUM_CAMERA_COMPONENTS; camera++)
+  {
+    s32 *const rectangle = &video_dirty_rectangles[camera * 4];
+    s32 *const rendered = &rendered_dirty_rectangles[camera * 4];
+    const s32 top = rectangle[0];
+    const s32 left = rectangle[1];
+    const s32 rows = rectangle[2];
+    const s32 columns = rectangle[3];
+
+    // The video buffer may have been resized since.
+    const s32 rendered_top = rendered[0];
+    const s32 rendered_left = rendered[1];
+    const s32 rendered_bottom = MIN(rendered_top + rendered[2], (s32)video_rows);
+    const s32 rendered_right = MIN(rendered_left + rendered[3], (s32)video_columns);
+
+    if (rendered_top < rendered_bottom && rendered_left < rendered_right)
+    {
+      if (rows && columns)
+      {
+        rectangle[0] = MIN(top, rendered_top);
+        rectangle[1] = MIN(left, rendered_left);
+        rectangle[2] = MAX(top + rows, rendered_bottom) - rectangle[0];
+        rectangle[3] = MAX(left + columns, rendered_right) - rectangle[1];
+      }
+      else
+      {
+        rectangle[0] = rendered_top;
+        rectangle[1] = rendered_left;
+        rectangle[2] = rendered_bottom - rendered_top;
+        rectangle[3] = rendered_right - rendered_left;
+      }
+    }
+
+    rendered[0] = top;
+    rendered[1] = left;
+    rendered[2] = rows;
+    rendered[3] = columns;
+  }
+}
+
+#define CAMERA_COMPONENT_SNAPSHOT_LIST(item)          \
+  SNAPSHOT_INDEX_POOL(item)                           \
+  item(transforms)                                    \
+  item(entities)                                      \
+  item(inverse_transforms)                            \
+  item(previous_camera_component_sensor_sizes)        \
+  item(next_camera_component_sensor_sizes)            \
+  item(previous_camera_component_near_clip_distances) \
+  item(next_camera_component_near_clip_distances)     \
+  item(previous_camera_component_far_clip_distances)  \
+  item(next_camera_component_far_clip_distances)      \
+  item(previous_camera_component_focal_lengths)       \
+  item(next_camera_component_focal_lengths)           \
+  item(previous_camera_component_gains)               \
+  item(next_camera_component_gains)                   \
+  item(previous_camera_component_tops)                \
+  item(next_camera_component_tops)                    \
+  item(previous_camera_component_bottoms)             \
+  item(next_camera_component_bottoms)                 \
+  item(previous_camera_component_lefts)               \
+  item(next_camera_component_lefts)                   \
+  item(previous_camera_component_rights)              \
+  item(next_camera_component_rights)                  \
+  item(camera_component_render_textures)              \
+  item(camera_component_culling_masks)
+
+SNAPSHOT_FUNCTIONS(CAMERA_COMPONENT_SNAPSHOT_LIST)
+
+void capture_camera_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_camera_components_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+
+  // Anything previously rendered into render textures was from another scene.
+  for (index camera = 0; camera < MAXIMUM_CAMERA_COMPONENTS; camera++)
+  {
+    stale[camera] = 1;
   }
 }
@@ -7,8 +7,10 @@
 #include "component.h"
 #include "../../primitives/quantity.h"
 #include "../../primitives/f32.h"
+#include "../../primitives/s32.h"
 #include "../../primitives/index.h"
 #include "../../math/matrix.h"
+#include "../../assets/render_texture.h"
 #include "../../../game/project_settings/limits.h"
 
 /**
@@ -27,6 +29,7 @@
  * @remark This defaults to covering the full video buffer.
  * @remark This defaults to playing sounds at unity gain (1.0).
  * @remark This defaults to filling the video buffer.
+ * @remark This defaults to rendering all layers.
  * @param entity The index of the entity to which to add a camera component.
  * @return A handle to the created camera component.
  */
@@ -49,6 +52,7 @@ component_handle camera_component(
  * @remark This defaults to covering the full video buffer.
  * @remark This defaults to playing sounds at unity gain (1.0).
  * @remark This defaults to filling the video buffer.
+ * @remark This defaults to rendering all layers.
  * @param component A handle to the component to which to add a camera
  *                  component.
  * @return A handle to the created camera component.
@@ -240,8 +244,44 @@ extern f32 previous_camera_component_rights[MAXIMUM_CAMERA_COMPONENTS];
  */
 extern f32 next_camera_component_rights[MAXIMUM_CAMERA_COMPONENTS];
 
+/**
+ * The render textures into which camera components render, or @ref NULL to
+ * render into the video buffer.
+ * @remark Modify only during scripts or the tick event handler (doing so in
+ *         other situations may produce unexpected results).
+ * @remark Use @ref COMPONENT_HANDLE_META to extract the index to use here from
+ *         a handle to a camera component.
+ * @remark Viewports are relative to the render texture rather than the video
+ *         buffer.
+ * @remark Render textures are only re-rendered when one of the camera
+ *         components rendering into them or the scene has changed, and are
+ *         rendered before the video buffer.  Behavior is undefined when a
+ *         render texture is sampled while rendering into itself.
+ */
+extern render_texture *camera_component_render_textures[MAXIMUM_CAMERA_COMPONENTS];
+
+/**
+ * The layers which camera components render, as a bit mask.  Only mesh
+ * components with at least one layer in common are rendered.
+ * @remark Modify only during scripts or the tick event handler (doing so in
+ *         other situations may produce unexpected results).
+ * @remark Use @ref COMPONENT_HANDLE_META to extract the index to use here from
+ *         a handle to a camera component.
+ * @remark This defaults to -1 (all layers).
+ */
+extern s32 camera_component_culling_masks[MAXIMUM_CAMERA_COMPONENTS];
+
 #ifndef DOXYGEN_IGNORE
 
+/**
+ * Checks that a number of camera components can be created.
+ * @remark Will throw a trap should there not be enough camera components left
+ *         to allocate.
+ * @param quantity The number of camera components which are about to be
+ *                 created.
+ */
+void reserve_camera_components(const quantity quantity);
+
 /**
  * A matrix which transforms from world space into the current camera
  * component's clip space.
@@ -351,6 +391,87 @@ extern f32 camera_component_clip_to_video_column_offset;
  */
 extern f32 camera_component_gain;
 
+/**
+ * The number of rows between the top of the current camera component's
+ * viewport and the first row written to since rendering of it began.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Use @ref mark_camera_component_dirty to modify.
+ */
+extern s32 camera_component_dirty_top;
+
+/**
+ * The number of columns between the left of the current camera component's
+ * viewport and the first column written to since rendering of it began.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Use @ref mark_camera_component_dirty to modify.
+ */
+extern s32 camera_component_dirty_left;
+
+/**
+ * The number of rows between the top of the current camera component's
+ * viewport and the row after the last written to since rendering of it began.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Use @ref mark_camera_component_dirty to modify.
+ */
+extern s32 camera_component_dirty_bottom;
+
+/**
+ * The number of columns between the left of the current camera component's
+ * viewport and the column after the last written to since rendering of it
+ * began.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Use @ref mark_camera_component_dirty to modify.
+ */
+extern s32 camera_component_dirty_right;
+
+/**
+ * Expands the region of the current camera component's viewport which has been
+ * written to during the current render to include a rectangle.
+ * @remark Only use when rendering video for a camera component.
+ * @remark The rectangle is clamped to the bounds of the viewport.  Empty
+ *         rectangles are ignored.
+ * @param top The number of rows between the top of the viewport and the top of
+ *            the rectangle.
+ * @param left The number of columns between the left of the viewport and the
+ *             left of the rectangle.
+ * @param bottom The number of rows between the top of the viewport and the row
+ *               after the bottom of the rectangle.
+ * @param right The number of columns between the left of the viewport and the
+ *              column after the right of the rectangle.
+ */
+void mark_camera_component_dirty(
+    const s32 top,
+    const s32 left,
+    const s32 bottom,
+    const s32 right);
+
+/**
+ * The layers rendered by the current camera component, as a bit mask.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Do NOT re-assign.
+ */
+extern s32 camera_component_culling_mask;
+
+/**
+ * The number of rows between the top of the current camera component's
+ * viewport and the pixel for which to determine
+ * @ref selectable_component_picked, or INDEX_NONE when that pixel is outside
+ * of the viewport.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Do NOT re-assign.
+ */
+extern s32 camera_component_picking_row;
+
+/**
+ * The number of columns between the left of the current camera component's
+ * viewport and the pixel for which to determine
+ * @ref selectable_component_picked, or INDEX_NONE when that pixel is outside
+ * of the viewport.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.  Do NOT re-assign.
+ */
+extern s32 camera_component_picking_column;
+
 /**
  * A callback which is called for each rendered camera component during a
  * render.
@@ -359,12 +480,38 @@ extern f32 camera_component_gain;
  */
 typedef void(render_camera_component)();
 
+/**
+ * Called by the video event handler to interpolate the parameters of all camera
+ * components ahead of @ref render_camera_components.
+ * @param changed_layers A bit mask of the layers on which anything has changed
+ *                       since the previous video event handler.  Render
+ *                       textures rendered by camera components culling any of
+ *                       these layers are marked stale.
+ * @return Non-zero when any parameter which affects what a camera component
+ *         renders (including its transform, culling mask and render texture)
+ *         differs from that of the previous video event handler, otherwise, 0.
+ */
+s32 prepare_camera_components_for_video(const s32 changed_layers);
+
 /**
  * Called by the video event handler to render all camera components.
  * @param on_render Called once per rendered camera component.
  */
 void render_camera_components(render_camera_component *const on_render);
 
+/**
+ * Copies the state of every camera component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_camera_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every camera component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_camera_components_snapshot(const index snapshot);
+
 #endif
 
 #endif
@@ -1,4 +1,3 @@
-
 #include "../../primitives/index.h"
 #include "../../primitives/quantity.h"
 #include "../../primitives/s32.h"
@@ -6,32 +5,145 @@
 #include "../../miscellaneous.h"
 #include "component.h"
 #include "../../exports/buffers/error.h"
+#include "../../exports/buffers/video.h"
+#include "../snapshot.h"
 
 #define COMPONENT_STATE_INACTIVE 0
 #define COMPONENT_STATE_ACTIVE 1
-#define COMPONENT_STATE_ACTIVE_WITH_CHILDREN 2
-#define COMPONENT_STATE_DELETING 3
+#define COMPONENT_STATE_DELETING 2
+
+index component_metas[MAXIMUM_COMPONENTS];
 
 static s32 states[MAXIMUM_COMPONENTS];
-static s32 handles[MAXIMUM_COMPONENTS];
+static component_handle handles[MAXIMUM_COMPONENTS];
 static component_destroyed *destructors[MAXIMUM_COMPONENTS];
+static index entities[MAXIMUM_COMPONENTS];
+static index parents[MAXIMUM_COMPONENTS];
+static index first_children[MAXIMUM_COMPONENTS];
+static index previous_siblings[MAXIMUM_COMPONENTS];
+static index next_siblings[MAXIMUM_COMPONENTS];
+static index first_children_of_entities[MAXIMUM_ENTITIES];
+static s32 destructions_deferred[MAXIMUM_COMPONENTS];
 
-static index first_occupied;
+// The slots marked through destructions_deferred, stored densely so that
+// only they are visited.
+static index deferred_slots[MAXIMUM_COMPONENTS];
+static index deferred_slot_positions[MAXIMUM_COMPONENTS];
+static quantity total_destructions_deferred;
+
+static index occupied[MAXIMUM_COMPONENTS];
+static index positions[MAXIMUM_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
 static index last_occupied;
 static quantity total_occupied;
 
+static void link(const index slot, index *const first_child)
+{
+  const index next_sibling = *first_child;
+
+  first_children[slot] = INDEX_NONE;
+  previous_siblings[slot] = INDEX_NONE;
+  next_siblings[slot] = next_sibling;
+
+  if (next_sibling != INDEX_NONE)
+  {
+    previous_siblings[next_sibling] = slot;
+  }
+
+  *first_child = slot;
+}
+
+static void unlink(const index slot, index *const first_child)
+{
+  const index previous_sibling = previous_siblings[slot];
+  const index next_sibling = next_siblings[slot];
+
+  if (previous_sibling == INDEX_NONE)
+  {
+    *first_child = next_sibling;
+  }
+  else
+  {
+    next_siblings[previous_sibling] = next_sibling;
+  }
+
+  if (next_sibling != INDEX_NONE)
+  {
+    previous_siblings[next_sibling] = previous_sibling;
+  }
+}
+
+static index *first_child_of_parent_of(const index slot)
+{
+  const index parent = parents[slot];
+
+  if (parent == INDEX_NONE)
+  {
+    return &first_children_of_entities[entities[slot]];
+  }
+  else
+  {
+    return &first_children[parent];
+  }
+}
+
+static index active_slot_of(const component_handle component)
+{
+  const index slot = COMPONENT_HANDLE_COMPONENT(component);
+
+  if (component >= 0 && slot < MAXIMUM_COMPONENTS && states[slot] == COMPONENT_STATE_ACTIVE && handles[slot] == component)
+  {
+    return slot;
+  }
+  else
+  {
+    throw(ERROR_COMPONENT_DOES_NOT_EXIST);
+  }
+}
+
+static component_handle allocate(
+    const index entity,
+    const index parent,
+    const index meta,
+    component_destroyed *const on_destroy)
+{
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_COMPONENTS_TO_ALLOCATE, slot)
+
+  // Fresh slots have a zeroed handle, so start at generation 1.
+  const s32 generation = (COMPONENT_HANDLE_GENERATION(handles[slot]) + 1) & ((1 << COMPONENT_HANDLE_BITS_FOR_GENERATION) - 1);
+  const component_handle component = slot | (generation << COMPONENT_HANDLE_BITS_FOR_COMPONENT);
+  states[slot] = COMPONENT_STATE_ACTIVE;
+  handles[slot] = component;
+  destructors[slot] = on_destroy;
+  component_metas[slot] = meta;
+  entities[slot] = entity;
+  parents[slot] = parent;
+  link(slot, parent == INDEX_NONE ? &first_children_of_entities[entity] : &first_children[parent]);
+  video_invalidated = 1;
+  return component;
+}
+
+void reserve_components(const quantity quantity)
+{
+  if (quantity > MAXIMUM_COMPONENTS - total_occupied)
+  {
+    throw(ERROR_NO_COMPONENTS_TO_ALLOCATE);
+  }
+}
+
+void initialize_components_of(const index entity)
+{
+  first_children_of_entities[entity] = INDEX_NONE;
+}
+
 component_handle component(
     const index entity,
     const index meta,
     component_destroyed *const on_destroy)
 {
   // TODO: Check entity exists
-  FIND_EMPTY_INDEX(states, COMPONENT_STATE_INACTIVE, MAXIMUM_COMPONENTS, first_occupied, last_occupied, total_occupied, ERROR_NO_COMPONENTS_TO_ALLOCATE, index)
-  const component_handle component = meta | (1 << COMPONENT_HANDLE_BITS_FOR_META) | (entity << (COMPONENT_HANDLE_BITS_FOR_META + 1)) | (index << (COMPONENT_HANDLE_BITS_FOR_META + 1 + COMPONENT_HANDLE_BITS_FOR_PARENT));
-  states[index] = COMPONENT_STATE_ACTIVE;
-  handles[index] = component;
-  destructors[index] = on_destroy;
-  return component;
+  return allocate(entity, INDEX_NONE, meta, on_destroy);
 }
 
 component_handle sub_component(
@@ -39,129 +151,183 @@ component_handle sub_component(
     const index meta,
     component_destroyed *const on_destroy)
 {
-  const index parent = COMPONENT_HANDLE_COMPONENT(component);
+  const index parent = active_slot_of(component);
+  return allocate(entities[parent], parent, meta, on_destroy);
+}
 
-  switch (states[parent])
-  {
-  case COMPONENT_STATE_ACTIVE:
-  case COMPONENT_STATE_ACTIVE_WITH_CHILDREN:
+static void destroy_unlinked(const index slot);
+
+static void destroy_all_children(index *const first_child)
+{
+  // Destructors may destroy other children, so unlink one at a time rather
+  // than walking the list.
+  while (*first_child != INDEX_NONE)
   {
-    FIND_EMPTY_INDEX(states, COMPONENT_STATE_INACTIVE, MAXIMUM_COMPONENTS, first_occupied, last_occupied, total_occupied, ERROR_NO_COMPONENTS_TO_ALLOCATE, index)
-    const component_handle component = meta | (1 << COMPONENT_HANDLE_BITS_FOR_META) | (parent << (COMPONENT_HANDLE_BITS_FOR_META + 1)) | (index << (COMPONENT_HANDLE_BITS_FOR_META + 1 + COMPONENT_HANDLE_BITS_FOR_PARENT));
-    states[index] = COMPONENT_STATE_ACTIVE;
-    handles[index] = component;
-    destructors[index] = on_destroy;
-    return component;
+    const index child = *first_child;
+    unlink(child, first_child);
+    destroy_unlinked(child);
   }
+}
 
-  default:
-    throw(ERROR_COMPONENT_DOES_NOT_EXIST);
+static void destroy_unlinked(const index slot)
+{
+  video_invalidated = 1;
+  states[slot] = COMPONENT_STATE_DELETING;
+
+  if (destructions_deferred[slot])
+  {
+    destructions_deferred[slot] = 0;
+    total_destructions_deferred--;
+    const index moved = deferred_slots[total_destructions_deferred];
+    const index position = deferred_slot_positions[slot];
+    deferred_slots[position] = moved;
+    deferred_slot_positions[moved] = position;
   }
+
+  destroy_all_children(&first_children[slot]);
+  destructors[slot](handles[slot]);
+  states[slot] = COMPONENT_STATE_INACTIVE;
+  INDEX_RELEASE(slot, occupied, positions, first_occupied, last_occupied, total_occupied)
 }
 
-static void destroy_all_sub_components_of_index(const index component)
+void destroy_component(const component_handle component)
 {
-  if (first_occupied != INDEX_NONE)
-  {
-    for (index index = first_occupied; index <= last_occupied; index++)
-    {
+  const index slot = active_slot_of(component);
+  unlink(slot, first_child_of_parent_of(slot));
+  destroy_unlinked(slot);
+}
 
-      const s32 state = states[index];
+index parent_entity_of(const component_handle component)
+{
+  return entities[active_slot_of(component)];
+}
 
-      switch (state)
-      {
-      case COMPONENT_STATE_ACTIVE:
-      {
-        const component_handle handle = handles[index];
-
-        if (COMPONENT_HANDLE_IS_CHILD_OF_COMPONENT(handle) && COMPONENT_HANDLE_PARENT(handle) == component)
-        {
-          states[index] = COMPONENT_STATE_DELETING;
-          destructors[index](handle);
-          states[index] = COMPONENT_STATE_INACTIVE;
-        }
-        break;
-      }
+void destroy_all_components_of(const index entity)
+{
+  destroy_all_children(&first_children_of_entities[entity]);
+}
 
-      case COMPONENT_STATE_ACTIVE_WITH_CHILDREN:
-      {
-        const component_handle handle = handles[index];
-
-        if (COMPONENT_HANDLE_IS_CHILD_OF_COMPONENT(handle) && COMPONENT_HANDLE_PARENT(handle) == component)
-        {
-          states[index] = COMPONENT_STATE_DELETING;
-          destroy_all_sub_components_of_index(index);
-          destructors[index](handle);
-          states[index] = COMPONENT_STATE_INACTIVE;
-        }
-        break;
-      }
-      }
-    }
+void defer_component_destruction(const component_handle component)
+{
+  const index slot = active_slot_of(component);
+
+  if (!destructions_deferred[slot])
+  {
+    destructions_deferred[slot] = 1;
+    deferred_slots[total_destructions_deferred] = slot;
+    deferred_slot_positions[slot] = total_destructions_deferred;
+    total_destructions_deferred++;
   }
 }
 
-void destroy_component(const component_handle component)
+void destroy_deferred_components()
 {
-  const index index = COMPONENT_HANDLE_COMPONENT(component);
-
-  switch (states[index])
+  // Each destruction removes itself (and anything else it destroys) from the
+  // list, so this always ends.
+  while (total_destructions_deferred > 0)
   {
-  case COMPONENT_STATE_ACTIVE:
-    states[index] = COMPONENT_STATE_DELETING;
-    destructors[index](component);
-    INDEX_VACATE(index, states, COMPONENT_STATE_INACTIVE, first_occupied, last_occupied, total_occupied)
-    break;
+    destroy_component(handles[deferred_slots[total_destructions_deferred - 1]]);
+  }
+}
 
-  case COMPONENT_STATE_ACTIVE_WITH_CHILDREN:
-    states[index] = COMPONENT_STATE_DELETING;
-    destroy_all_sub_components_of_index(index);
-    destructors[index](component);
-    INDEX_VACATE(index, states, COMPONENT_STATE_INACTIVE, first_occupied, last_occupied, total_occupied)
-    break;
+#define COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)           \
+  item(component_metas)               \
+  item(states)                        \
+  item(handles)                       \
+  item(destructors)                   \
+  item(entities)                      \
+  item(parents)                       \
+  item(first_children)                \
+  item(previous_siblings)             \
+  item(next_siblings)                 \
+  item(first_children_of_entities)    \
+  item(destructions_deferred)         \
+  item(deferred_slots)                \
+  item(deferred_slot_positions)       \
+  item(total_destructions_deferred)
 
-  default:
-    throw(ERROR_COMPONENT_DOES_NOT_EXIST);
-  }
+SNAPSHOT_FUNCTIONS(COMPONENT_SNAPSHOT_LIST)
+
+void capture_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
 }
 
-index parent_entity_of(const component_handle component)
+void restore_components_snapshot(const index snapshot)
 {
-  switch (states[COMPONENT_HANDLE_COMPONENT(component)])
-  {
-  case COMPONENT_STATE_ACTIVE:
-  case COMPONENT_STATE_ACTIVE_WITH_CHILDREN:
-  {
-    component_handle recursed = component;
+  restore_snapshot(snapshot);
+  video_invalidated = 1;
+}
 
-    while (COMPONENT_HANDLE_IS_CHILD_OF_COMPONENT(recursed))
+#ifdef DEVELOPMENT
+
+static quantity validate_children(const index first_child, const index parent)
+{
+  quantity total = 0;
+  index previous_sibling = INDEX_NONE;
+
+  for (index child = first_child; child != INDEX_NONE; child = next_siblings[child])
+  {
+    if (states[child] != COMPONENT_STATE_ACTIVE || previous_siblings[child] != previous_sibling || COMPONENT_HANDLE_COMPONENT(handles[child]) != child || parents[child] != parent || total == total_occupied)
     {
-      recursed = handles[COMPONENT_HANDLE_PARENT(recursed)];
+      throw(ERROR_COMPONENT_HIERARCHY_INCONSISTENT);
     }
 
-    return COMPONENT_HANDLE_PARENT(recursed);
+    previous_sibling = child;
+    total++;
   }
 
-  default:
-    throw(ERROR_COMPONENT_DOES_NOT_EXIST);
-  }
+  return total;
 }
 
-void destroy_all_components_of(const index entity)
+void validate_components()
 {
-  if (first_occupied != INDEX_NONE)
+  quantity total_linked = 0;
+
+  for (index position = 0; position < total_occupied; position++)
   {
-    for (index component = first_occupied; component <= last_occupied; component++)
+    const index slot = occupied[position];
+
+    if (states[slot] != COMPONENT_STATE_ACTIVE)
     {
-      if (states[component] == COMPONENT_STATE_ACTIVE)
-      {
-        const component_handle handle = handles[component];
+      throw(ERROR_COMPONENT_HIERARCHY_INCONSISTENT);
+    }
+
+    index root = slot;
+    quantity depth = 0;
 
-        if (COMPONENT_HANDLE_IS_CHILD_OF_ENTITY(handle) && COMPONENT_HANDLE_PARENT(handle) == entity)
-        {
-          destroy_component(handles[component]);
-        }
+    while (parents[root] != INDEX_NONE)
+    {
+      root = parents[root];
+
+      if (++depth == total_occupied)
+      {
+        throw(ERROR_COMPONENT_HIERARCHY_INCONSISTENT);
       }
     }
+
+    const index entity = entities[slot];
+
+    if (entities[root] != entity)
+    {
+      throw(ERROR_COMPONENT_HIERARCHY_INCONSISTENT);
+    }
+
+    total_linked += validate_children(first_children[slot], slot);
+
+    // Each entity's list is walked once, from the component at its head.
+    if (parents[slot] == INDEX_NONE && first_children_of_entities[entity] == slot)
+    {
+      total_linked += validate_children(slot, INDEX_NONE);
+    }
+  }
+
+  // Anything unreachable from its parent's list would otherwise go unnoticed.
+  if (total_linked != total_occupied)
+  {
+    throw(ERROR_COMPONENT_HIERARCHY_INCONSISTENT);
   }
 }
+
+#endif
@@ -6,96 +6,67 @@
 
 #include "../../primitives/index.h"
 #include "../../primitives/s32.h"
+#include "../../primitives/quantity.h"
 #include "../../../game/project_settings/limits.h"
 #include "../../miscellaneous.h"
 
 /**
- * The number of bits used to store indices specific to component types within
- * component handles.
+ * The number of bits used to store component indices within component handles.
  */
-#define COMPONENT_HANDLE_BITS_FOR_META 8
+#define COMPONENT_HANDLE_BITS_FOR_COMPONENT 16
 
 /**
- * The number of bits used to store parent entity or component indices within
- * component handles.
+ * The number of bits used to store generation counters within component
+ * handles.
  */
-#define COMPONENT_HANDLE_BITS_FOR_PARENT 8
+#define COMPONENT_HANDLE_BITS_FOR_GENERATION 14
 
-/**
- * The number of bits used to store component indices within component handles.
- */
-#define COMPONENT_HANDLE_BITS_FOR_COMPONENT 8
-
-ASSERT(too_many_bits_for_component_handle, COMPONENT_HANDLE_BITS_FOR_META + COMPONENT_HANDLE_BITS_FOR_PARENT + COMPONENT_HANDLE_BITS_FOR_COMPONENT <= 30);
-ASSERT(too_few_meta_bits_for_timer_components, MAXIMUM_TIMER_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_META));
-ASSERT(too_few_meta_bits_for_sound_components, MAXIMUM_SOUND_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_META));
-ASSERT(too_few_meta_bits_for_camera_components, MAXIMUM_CAMERA_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_META));
-ASSERT(too_few_meta_bits_for_mesh_components, MAXIMUM_MESH_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_META));
-ASSERT(too_few_parent_bits_for_entities, MAXIMUM_ENTITIES <= (1 << COMPONENT_HANDLE_BITS_FOR_PARENT));
-ASSERT(too_few_parent_bits_for_components, MAXIMUM_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_PARENT));
+ASSERT(too_many_bits_for_component_handle, COMPONENT_HANDLE_BITS_FOR_COMPONENT + COMPONENT_HANDLE_BITS_FOR_GENERATION <= 30);
 ASSERT(too_few_component_bits, MAXIMUM_COMPONENTS <= (1 << COMPONENT_HANDLE_BITS_FOR_COMPONENT));
 
 /**
  * A handle to a component.
- * @remark This is composed of four fields of bits, from least to most
+ * @remark This is composed of two fields of bits, from least to most
  *         significant:
- *         - An index which is specific to the component type itself.  This can
- *           be extracted using @ref COMPONENT_HANDLE_META.
- *         - A bit specifying whether the component is the child of an entity
- *           or another component.  This can be checked using
- *           @ref COMPONENT_HANDLE_IS_CHILD_OF_ENTITY or
- *           @ref COMPONENT_HANDLE_IS_CHILD_OF_COMPONENT.
- *         - The index of the component's parent entity or component in the
- *           global pool (primarily used to handle destruction).  This can be
- *           extracted using @ref COMPONENT_HANDLE_PARENT.
- *         - The index of the component itself in the global pool (primarily
- *           used to handle its destruction).  This can be extracted using
- *           @ref COMPONENT_HANDLE_COMPONENT.
+ *         - The index of the component itself in the global pool.  This can be
+ *           extracted using @ref COMPONENT_HANDLE_COMPONENT.
+ *         - A generation counter which is incremented each time that index is
+ *           re-used, so that handles to destroyed components can be detected
+ *           rather than acting upon whichever component replaced them.  This
+ *           can be extracted using @ref COMPONENT_HANDLE_GENERATION.
  */
 typedef s32 component_handle;
 
 /**
- * Extracts the index specific to a type of component from a handle to it.
- * @param component_handle The component handle from which to extract the index
- *                         specific to the component type.
- * @return The index specific to the component type.
- */
-#define COMPONENT_HANDLE_META(component_handle) ((component_handle) & ((1 << COMPONENT_HANDLE_BITS_FOR_META) - 1))
-
-/**
- * Determines whether a component handle is for the direct child of an entity.
- * @param component_handle The component handle to check.
- * @return Truthy when the component handle is the direct child of an entity,
- *         otherwise, falsy.
+ * The indices specific to component types, by the index of each component in
+ * the global pool.
+ * @remark Do not modify this; use @ref COMPONENT_HANDLE_META to read it.
  */
-#define COMPONENT_HANDLE_IS_CHILD_OF_ENTITY(component_handle) ((component_handle) & (1 << COMPONENT_HANDLE_BITS_FOR_META))
+extern index component_metas[MAXIMUM_COMPONENTS];
 
 /**
- * Determines whether a component handle is for the direct child of a component.
- * @param component_handle The component handle to check.
- * @return Truthy when the component handle is the direct child of a component,
- *         otherwise, falsy.
+ * Extracts the index of the component itself from a handle to it.
+ * @param component_handle The component handle from which to extract the index
+ *                         of the component itself.
+ * @return The index of the component itself.
  */
-#define COMPONENT_HANDLE_IS_CHILD_OF_COMPONENT(component_handle) (!((component_handle) & (1 << COMPONENT_HANDLE_BITS_FOR_META)))
+#define COMPONENT_HANDLE_COMPONENT(component_handle) ((component_handle) & ((1 << COMPONENT_HANDLE_BITS_FOR_COMPONENT) - 1))
 
 /**
- * Extracts the parent index from a component handle.
- * @remark Use @ref COMPONENT_HANDLE_IS_CHILD_OF_ENTITY and
- *         @ref COMPONENT_HANDLE_IS_CHILD_OF_CHILD to determine what the index
- *         refers to.
- * @param component_handle The component handle from which to extract the parent
- *                         index.
- * @return The parent index of the component handle.
+ * Extracts the generation counter from a component handle.
+ * @param component_handle The component handle from which to extract the
+ *                         generation counter.
+ * @return The generation counter of the component handle.
  */
-#define COMPONENT_HANDLE_PARENT(component_handle) (((component_handle) >> (COMPONENT_HANDLE_BITS_FOR_META + 1)) & ((1 << COMPONENT_HANDLE_BITS_FOR_PARENT) - 1))
+#define COMPONENT_HANDLE_GENERATION(component_handle) ((component_handle) >> COMPONENT_HANDLE_BITS_FOR_COMPONENT)
 
 /**
- * Extracts the index of the component itself from a handle to it.
- * @param component_handle The component handle from which to extract the index
- *                         of the component itself.
- * @return The index of the component itself.
+ * Looks up the index specific to a type of component from a handle to it.
+ * @param component_handle The component handle for which to look up the index
+ *                         specific to the component type.
+ * @return The index specific to the component type.
  */
-#define COMPONENT_HANDLE_COMPONENT(component_handle) ((component_handle) >> (COMPONENT_HANDLE_BITS_FOR_META + 1 + COMPONENT_HANDLE_BITS_FOR_PARENT))
+#define COMPONENT_HANDLE_META(component_handle) (component_metas[COMPONENT_HANDLE_COMPONENT(component_handle)])
 
 /**
  * A value which can be used in place of a component handle to represent
@@ -121,8 +92,7 @@ typedef void(component_destroyed)(component_handle component);
  *         of calling.
  * @param entity The index of the entity to which to add a component.
  * @param meta An arbitrary index which can be used to look up
- *             component-type-specific data.  Cannot be greater than
- *             @see COMPONENT_META_MAX.
+ *             component-type-specific data.
  * @param on_destroy Called when the component is destroyed.
  * @return A handle to the created component.
  */
@@ -140,8 +110,7 @@ component_handle component(
  *         time of calling.
  * @param component A handle to the component to which to add a component.
  * @param meta An arbitrary index which can be used to look up
- *             component-type-specific data.  Cannot be greater than
- *             @see COMPONENT_META_MAX.
+ *             component-type-specific data.
  * @param on_destroy Called when the component is destroyed.
  * @return A handle to the created component.
  */
@@ -156,16 +125,18 @@ component_handle sub_component(
  *         situations may produce unexpected results).
  * @remark Will throw a trap should the specified component not exist at the
  *         time of calling.
- * @remark The component's index and the indices of all components within it
- *         will be re-used; ensure that any copies of them are not used once
- *         this call starts.
+ * @remark Handles to the component and all components within it will no
+ *         longer be considered to exist once this call starts, but their
+ *         component-type-specific indices will be re-used; ensure that any
+ *         copies of those are not used once this call starts.
  * @param component A handle to the component to destroy.
  */
 void destroy_component(const component_handle component);
 
 /**
- * Finds the index of the parent entity of a given component handle.  Will
- * recurse up the tree if its direct parent is a component.
+ * Finds the index of the parent entity of a given component handle, recursing
+ * up the tree if its direct parent is a component.  This is cached when the
+ * component is created, so runs in constant time.
  * @remark Will throw a trap should the specified component not exist at the
  *         time of calling.
  * @param component The component handle for which to find the parent entity.
@@ -182,4 +153,69 @@ index parent_entity_of(const component_handle component);
  */
 void destroy_all_components_of(const index entity);
 
+/**
+ * Marks a previously created component to be destroyed (as though by
+ * @ref destroy_component) at the end of the current tick, or the next should
+ * this be called outside of one.  Deferred destructions are applied together,
+ * in order of component index, after all tick and timer components have been
+ * executed.
+ * @remark Call only during scripts or the tick event handler (doing so in other
+ *         situations may produce unexpected results).
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @remark The component continues to exist until then; calling this multiple
+ *         times has no further effect.  Should it be destroyed by any other
+ *         means first, nothing further happens.
+ * @param component A handle to the component to destroy.
+ */
+void defer_component_destruction(const component_handle component);
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * Called when an entity is created to mark it as having no components.
+ * @param entity The index of the created entity.
+ */
+void initialize_components_of(const index entity);
+
+/**
+ * Checks that a number of components can be created.
+ * @remark Will throw a trap should there not be enough components left to
+ *         allocate.
+ * @param quantity The number of components which are about to be created.
+ */
+void reserve_components(const quantity quantity);
+
+/**
+ * Called at the end of the tick event handler to destroy all components marked
+ * through @ref defer_component_destruction.
+ */
+void destroy_deferred_components();
+
+/**
+ * Copies the state of every component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_components_snapshot(const index snapshot);
+
+#ifdef DEVELOPMENT
+
+/**
+ * Checks that the cached parent entity, child and sibling links of every
+ * component agree with their handles.
+ * @remark Will throw a trap should any inconsistency be found.
+ */
+void validate_components();
+
+#endif
+
+#endif
+
 #endif
@@ -3,31 +3,61 @@
 #include "../../assets/mesh.h"
 #include "../../primitives/index.h"
 #include "../../primitives/quantity.h"
+#include "../../primitives/s32.h"
 #include "../../math/matrix.h"
 #include "../../../game/project_settings/limits.h"
 #include "../../exports/buffers/error.h"
+#include "camera_component.h"
+#include "mesh_component.h"
+#include "selectable_component.h"
+#include "../snapshot.h"
 
-static index first_occupied_opaque_cutout;
-static index last_occupied_opaque_cutout;
-static quantity total_occupied_opaque_cutout;
+static quantity total_opaque_cutout;
 static const matrix *opaque_cutout_transforms[MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS];
-static const matrix *inverse_opaque_cutout_transforms[MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS];
 static const mesh *opaque_cutout_meshes[MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS];
+static index opaque_cutout_metas[MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS];
 
-static index first_occupied_additive_blended;
-static index last_occupied_additive_blended;
-static quantity total_occupied_additive_blended;
+static quantity total_additive_blended;
 static const matrix *additive_blended_transforms[MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS];
-static const matrix *inverse_additive_blended_transforms[MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS];
 static const mesh *additive_blended_meshes[MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS];
+static index additive_blended_metas[MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS];
 
-static index first_occupied;
+static index occupied[MAXIMUM_MESH_COMPONENTS];
+static index positions[MAXIMUM_MESH_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
 static index last_occupied;
 static quantity total_occupied;
 static const matrix *transforms[MAXIMUM_MESH_COMPONENTS];
-static const matrix *inverse_transforms[MAXIMUM_MESH_COMPONENTS];
 static index opaque_cutout[MAXIMUM_MESH_COMPONENTS];
 static index additive_blended[MAXIMUM_MESH_COMPONENTS];
+static index entities[MAXIMUM_MESH_COMPONENTS];
+
+s32 mesh_component_layers[MAXIMUM_MESH_COMPONENTS];
+
+static void remove_opaque_cutout(const index meta)
+{
+  const index position = opaque_cutout[meta];
+  total_opaque_cutout--;
+  opaque_cutout_transforms[position] = opaque_cutout_transforms[total_opaque_cutout];
+  opaque_cutout_meshes[position] = opaque_cutout_meshes[total_opaque_cutout];
+  const index moved = opaque_cutout_metas[total_opaque_cutout];
+  opaque_cutout_metas[position] = moved;
+  opaque_cutout[moved] = position;
+  opaque_cutout[meta] = INDEX_NONE;
+}
+
+static void remove_additive_blended(const index meta)
+{
+  const index position = additive_blended[meta];
+  total_additive_blended--;
+  additive_blended_transforms[position] = additive_blended_transforms[total_additive_blended];
+  additive_blended_meshes[position] = additive_blended_meshes[total_additive_blended];
+  const index moved = additive_blended_metas[total_additive_blended];
+  additive_blended_metas[position] = moved;
+  additive_blended[moved] = position;
+  additive_blended[meta] = INDEX_NONE;
+}
 
 static void set_mesh(const index meta, const mesh *const mesh)
 {
@@ -37,17 +67,22 @@ static void set_mesh(const index meta, const mesh *const mesh)
   {
     if (opaque_cutout_index != INDEX_NONE)
     {
-      INDEX_VACATE(opaque_cutout_index, opaque_cutout_meshes, NULL, first_occupied_opaque_cutout, last_occupied_opaque_cutout, total_occupied_opaque_cutout)
-      opaque_cutout[meta] = INDEX_NONE;
+      remove_opaque_cutout(meta);
     }
   }
   else if (opaque_cutout_index == INDEX_NONE)
   {
-    FIND_EMPTY_INDEX(opaque_cutout_meshes, NULL, MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS, first_occupied_opaque_cutout, last_occupied_opaque_cutout, total_occupied_opaque_cutout, ERROR_NO_OPAQUE_CUTOUT_MESH_COMPONENTS_TO_ALLOCATE, opaque_cutout_index)
-    opaque_cutout_transforms[opaque_cutout_index] = transforms[meta];
-    inverse_opaque_cutout_transforms[opaque_cutout_index] = inverse_transforms[meta];
-    opaque_cutout_meshes[opaque_cutout_index] = mesh;
-    opaque_cutout[meta] = opaque_cutout_index;
+    if (total_opaque_cutout == MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS)
+    {
+      throw(ERROR_NO_OPAQUE_CUTOUT_MESH_COMPONENTS_TO_ALLOCATE);
+    }
+
+    const index position = total_opaque_cutout;
+    total_opaque_cutout++;
+    opaque_cutout_transforms[position] = transforms[meta];
+    opaque_cutout_meshes[position] = mesh;
+    opaque_cutout_metas[position] = meta;
+    opaque_cutout[meta] = position;
   }
 
   const index additive_blended_index = additive_blended[meta];
@@ -56,28 +91,56 @@ static void set_mesh(const index meta, const mesh *const mesh)
   {
     if (additive_blended_index != INDEX_NONE)
     {
-      INDEX_VACATE(additive_blended_index, additive_blended_meshes, NULL, first_occupied_additive_blended, last_occupied_additive_blended, total_occupied_additive_blended)
-      additive_blended[meta] = INDEX_NONE;
+      remove_additive_blended(meta);
     }
   }
   else if (additive_blended_index == INDEX_NONE)
   {
-    FIND_EMPTY_INDEX(additive_blended_meshes, NULL, MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS, first_occupied_additive_blended, last_occupied_additive_blended, total_occupied_additive_blended, ERROR_NO_ADDITIVE_BLENDED_MESH_COMPONENTS_TO_ALLOCATE, additive_blended_index)
-    additive_blended_transforms[additive_blended_index] = transforms[meta];
-    inverse_additive_blended_transforms[additive_blended_index] = inverse_transforms[meta];
-    additive_blended_meshes[additive_blended_index] = mesh;
-    additive_blended[meta] = additive_blended_index;
+    if (total_additive_blended == MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS)
+    {
+      throw(ERROR_NO_ADDITIVE_BLENDED_MESH_COMPONENTS_TO_ALLOCATE);
+    }
+
+    const index position = total_additive_blended;
+    total_additive_blended++;
+    additive_blended_transforms[position] = transforms[meta];
+    additive_blended_meshes[position] = mesh;
+    additive_blended_metas[position] = meta;
+    additive_blended[meta] = position;
+  }
+}
+
+void reserve_mesh_components(
+    const quantity total,
+    const quantity opaque_cutout,
+    const quantity additive_blended)
+{
+  if (total > MAXIMUM_MESH_COMPONENTS - total_occupied)
+  {
+    throw(ERROR_NO_MESH_COMPONENTS_TO_ALLOCATE);
+  }
+
+  if (opaque_cutout > MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS - total_opaque_cutout)
+  {
+    throw(ERROR_NO_OPAQUE_CUTOUT_MESH_COMPONENTS_TO_ALLOCATE);
+  }
+
+  if (additive_blended > MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS - total_additive_blended)
+  {
+    throw(ERROR_NO_ADDITIVE_BLENDED_MESH_COMPONENTS_TO_ALLOCATE);
   }
 }
 
 static index allocate(const index entity, const mesh *const mesh)
 {
-  FIND_EMPTY_INDEX(transforms, NULL, MAXIMUM_MESH_COMPONENTS, first_occupied, last_occupied, total_occupied, ERROR_NO_MESH_COMPONENTS_TO_ALLOCATE, meta)
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_MESH_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_MESH_COMPONENTS_TO_ALLOCATE, meta)
 
   transforms[meta] = &entity_model_view_projections[entity];
-  inverse_transforms[meta] = &inverse_entity_model_view_projections[entity];
   opaque_cutout[meta] = INDEX_NONE;
   additive_blended[meta] = INDEX_NONE;
+  entities[meta] = entity;
+  mesh_component_layers[meta] = 1;
+  reference_renderable_entity(entity, 0);
   set_mesh(meta, mesh);
 
   return meta;
@@ -91,19 +154,18 @@ static void destroy(const component_handle component)
 
   if (opaque_cutout_index != INDEX_NONE)
   {
-    INDEX_VACATE(opaque_cutout_index, opaque_cutout_meshes, NULL, first_occupied_opaque_cutout, last_occupied_opaque_cutout, total_occupied_opaque_cutout)
-    opaque_cutout[meta] = INDEX_NONE;
+    remove_opaque_cutout(meta);
   }
 
   const index additive_blended_index = additive_blended[meta];
 
   if (additive_blended_index != INDEX_NONE)
   {
-    INDEX_VACATE(additive_blended_index, additive_blended_meshes, NULL, first_occupied_additive_blended, last_occupied_additive_blended, total_occupied_additive_blended)
-    additive_blended[meta] = INDEX_NONE;
+    remove_additive_blended(meta);
   }
 
-  transforms[meta] = NULL;
+  dereference_renderable_entity(entities[meta], 0);
+  INDEX_RELEASE(meta, occupied, positions, first_occupied, last_occupied, total_occupied)
 }
 
 component_handle mesh_component(
@@ -122,34 +184,64 @@ component_handle mesh_sub_component(
   return sub_component(component, meta, destroy);
 }
 
+void prepare_mesh_components_for_video()
+{
+  for (index position = 0; position < total_occupied; position++)
+  {
+    const index meta = occupied[position];
+    entity_layers[entities[meta]] |= mesh_component_layers[meta];
+  }
+}
+
 void render_opaque_cutout_mesh_components()
 {
-  if (first_occupied_opaque_cutout != INDEX_NONE)
+  for (index position = 0; position < total_opaque_cutout; position++)
   {
-    for (index index = first_occupied_opaque_cutout; index <= last_occupied_opaque_cutout; index++)
-    {
-      const mesh *const mesh = opaque_cutout_meshes[index];
+    const index meta = opaque_cutout_metas[position];
 
-      if (mesh != NULL)
-      {
-        render_opaque_cutout_mesh(mesh, *opaque_cutout_transforms[index]);
-      }
+    if (mesh_component_layers[meta] & camera_component_culling_mask)
+    {
+      selectable_component_rendering = selectable_component_of_entity(entities[meta]);
+      render_opaque_cutout_mesh(opaque_cutout_meshes[position], *opaque_cutout_transforms[position]);
     }
   }
 }
 
 void render_additive_blended_mesh_components()
 {
-  if (first_occupied_additive_blended != INDEX_NONE)
+  for (index index = 0; index < total_additive_blended; index++)
   {
-    for (index index = first_occupied_additive_blended; index <= last_occupied_additive_blended; index++)
+    if (mesh_component_layers[additive_blended_metas[index]] & camera_component_culling_mask)
     {
-      const mesh *const mesh = additive_blended_meshes[index];
-
-      if (mesh != NULL)
-      {
-        render_additive_blended_mesh(mesh, *additive_blended_transforms[index]);
-      }
+      render_additive_blended_mesh(additive_blended_meshes[index], *additive_blended_transforms[index]);
     }
   }
 }
+
+#define MESH_COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)                \
+  item(total_opaque_cutout)                \
+  item(opaque_cutout_transforms)           \
+  item(opaque_cutout_meshes)               \
+  item(opaque_cutout_metas)                \
+  item(total_additive_blended)             \
+  item(additive_blended_transforms)        \
+  item(additive_blended_meshes)            \
+  item(additive_blended_metas)             \
+  item(transforms)                         \
+  item(opaque_cutout)                      \
+  item(additive_blended)                   \
+  item(entities)                           \
+  item(mesh_component_layers)
+
+SNAPSHOT_FUNCTIONS(MESH_COMPONENT_SNAPSHOT_LIST)
+
+void capture_mesh_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_mesh_components_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+}
@@ -6,6 +6,8 @@
 
 #include "component.h"
 #include "../../primitives/index.h"
+#include "../../primitives/s32.h"
+#include "../../../game/project_settings/limits.h"
 #include "../../assets/mesh.h"
 
 /**
@@ -17,6 +19,7 @@
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified entity not exist at the time
  *         of calling.
+ * @remark This defaults to the first layer only (1).
  * @param entity The index of the entity to which to add a mesh component.
  * @param mesh The initial mesh to display.
  * @return A handle to the created mesh component.
@@ -34,6 +37,7 @@ component_handle mesh_component(
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified component not exist at the
  *         time of calling.
+ * @remark This defaults to the first layer only (1).
  * @param component A handle to the component to which to add an mesh component.
  * @param mesh The initial mesh to display.
  * @return A handle to the created mesh component.
@@ -42,8 +46,39 @@ component_handle mesh_sub_component(
     const component_handle component,
     const mesh *const mesh);
 
+/**
+ * The layers on which mesh components are visible, as a bit mask.  Only camera
+ * components with at least one layer in common render them.
+ * @remark Modify only during scripts or the tick event handler (doing so in
+ *         other situations may produce unexpected results).
+ * @remark Use @ref COMPONENT_HANDLE_META to extract the index to use here from
+ *         a handle to a mesh component.
+ */
+extern s32 mesh_component_layers[MAXIMUM_MESH_COMPONENTS];
+
 #ifndef DOXYGEN_IGNORE
 
+/**
+ * Checks that a number of mesh components can be created.
+ * @remark Will throw a trap should there not be enough mesh components, or
+ *         mesh components with opaque and/or cutout or additive and/or blended
+ *         geometry, left to allocate.
+ * @param total The number of mesh components which are about to be created.
+ * @param opaque_cutout The number of those with opaque and/or cutout geometry.
+ * @param additive_blended The number of those with additive and/or blended
+ *                         geometry.
+ */
+void reserve_mesh_components(
+    const quantity total,
+    const quantity opaque_cutout,
+    const quantity additive_blended);
+
+/**
+ * Called by the video event handler before interpolating entities to
+ * accumulate the layers of all mesh components into @ref entity_layers.
+ */
+void prepare_mesh_components_for_video();
+
 /**
  * Called by the video event handler once per camera to render all opaque and
  * cutout mesh components.
@@ -56,6 +91,19 @@ void render_opaque_cutout_mesh_components();
  */
 void render_additive_blended_mesh_components();
 
+/**
+ * Copies the state of every mesh component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_mesh_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every mesh component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_mesh_components_snapshot(const index snapshot);
+
 #endif
 
 #endif
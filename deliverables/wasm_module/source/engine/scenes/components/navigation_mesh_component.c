@@ -0,0 +1,212 @@
+#include "../../primitives/index.h"
+#include "../../primitives/quantity.h"
+#include "../../primitives/f32.h"
+#include "../../math/vector.h"
+#include "../../miscellaneous.h"
+#include "../../assets/navigation_mesh.h"
+#include "../../../game/project_settings/limits.h"
+#include "../../../game/project_settings/timing_settings.h"
+#include "../../exports/buffers/error.h"
+#include "../entity.h"
+#include "../snapshot.h"
+#include "component.h"
+#include "navigation_mesh_component.h"
+
+// The most edges which can be crossed (or slid along) in a single tick.  Any
+// movement remaining after this many is discarded, which only happens when
+// moving very quickly over very small faces or wedged into a corner.
+#define NAVIGATION_MESH_COMPONENT_MAXIMUM_CROSSINGS 8
+
+vector navigation_mesh_component_velocities[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+
+static index occupied[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+static index positions[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
+static index last_occupied;
+static quantity total_occupied;
+
+static index entities[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+static const navigation_mesh *navigation_meshes[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+static index faces[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+
+static void destroy(const component_handle component)
+{
+  const index agent = COMPONENT_HANDLE_META(component);
+  INDEX_RELEASE(agent, occupied, positions, first_occupied, last_occupied, total_occupied)
+}
+
+static index allocate(
+    const index entity,
+    const navigation_mesh *const navigation_mesh,
+    const index face)
+{
+  if (face < 0 || face >= navigation_mesh->count)
+  {
+    throw(ERROR_NAVIGATION_MESH_FACE_INVALID);
+  }
+
+  if (entity_parent(entity) != INDEX_NONE)
+  {
+    throw(ERROR_NAVIGATION_MESH_COMPONENT_ENTITY_HAS_PARENT);
+  }
+
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_NAVIGATION_MESH_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_NAVIGATION_MESH_COMPONENTS_TO_ALLOCATE, agent)
+  entities[agent] = entity;
+  navigation_meshes[agent] = navigation_mesh;
+  faces[agent] = face;
+  copy_f32(0.0f, navigation_mesh_component_velocities[agent], VECTOR_COMPONENTS);
+
+  return agent;
+}
+
+component_handle navigation_mesh_component(
+    const index entity,
+    const navigation_mesh *const navigation_mesh,
+    const index face)
+{
+  const index agent = allocate(entity, navigation_mesh, face);
+  return component(entity, agent, destroy);
+}
+
+component_handle navigation_mesh_sub_component(
+    const component_handle component,
+    const navigation_mesh *const navigation_mesh,
+    const index face)
+{
+  const index agent = allocate(parent_entity_of(component), navigation_mesh, face);
+  return sub_component(component, agent, destroy);
+}
+
+index navigation_mesh_component_face(const component_handle component)
+{
+  // Throws should the component not exist.
+  parent_entity_of(component);
+
+  return faces[COMPONENT_HANDLE_META(component)];
+}
+
+// Moves a location by a displacement within a face, crossing into neighboring
+// faces and sliding along walls as they are reached.  Only the edges of the
+// current face are ever considered.
+static index step(
+    const navigation_mesh *const navigation_mesh,
+    index face,
+    vector location,
+    vector remaining)
+{
+  for (index crossing = 0; crossing < NAVIGATION_MESH_COMPONENT_MAXIMUM_CROSSINGS; crossing++)
+  {
+    const quantity edges = navigation_mesh->vertex_counts[face];
+    const f32 *const vertex_locations = navigation_mesh->vertex_locations[face];
+    const f32 *const edge_exit_normals = navigation_mesh->edge_exit_normals[face];
+    f32 nearest_progress = 1.0f;
+    index nearest_edge = INDEX_NONE;
+
+    for (index edge = 0; edge < edges; edge++)
+    {
+      const f32 *const exit_normal = &edge_exit_normals[edge * VECTOR_COMPONENTS];
+      const f32 speed = dot_product(remaining, exit_normal);
+
+      if (speed > 0.0f)
+      {
+        vector to_edge;
+        subtract_vectors(&vertex_locations[edge * VECTOR_COMPONENTS], location, to_edge);
+        const f32 progress = dot_product(to_edge, exit_normal) / speed;
+
+        if (progress < nearest_progress)
+        {
+          nearest_progress = progress < 0.0f ? 0.0f : progress;
+          nearest_edge = edge;
+        }
+      }
+    }
+
+    if (nearest_edge == INDEX_NONE)
+    {
+      add_vectors(location, remaining, location);
+      return face;
+    }
+
+    vector travelled;
+    multiply_vector_by_scalar(remaining, nearest_progress, travelled);
+    add_vectors(location, travelled, location);
+    subtract_vectors(remaining, travelled, remaining);
+
+    const index neighbor = navigation_mesh->neighbor_faces[face][nearest_edge];
+
+    if (neighbor == INDEX_NONE)
+    {
+      // Walls remove any movement into them, leaving that along them.
+      const f32 *const exit_normal = &edge_exit_normals[nearest_edge * VECTOR_COMPONENTS];
+      vector into_wall;
+      multiply_vector_by_scalar(exit_normal, dot_product(remaining, exit_normal), into_wall);
+      subtract_vectors(remaining, into_wall, remaining);
+    }
+    else
+    {
+      face = neighbor;
+    }
+  }
+
+  return face;
+}
+
+static void constrain_to_surface(
+    const navigation_mesh *const navigation_mesh,
+    const index face,
+    vector location)
+{
+  const f32 *const surface_normal = &navigation_mesh->surface_normals[face * VECTOR_COMPONENTS];
+  vector from_surface, offset;
+  subtract_vectors(location, navigation_mesh->vertex_locations[face], from_surface);
+  multiply_vector_by_scalar(surface_normal, dot_product(from_surface, surface_normal), offset);
+  subtract_vectors(location, offset, location);
+}
+
+void execute_navigation_mesh_components()
+{
+  // All navigation mesh components are moved together, after anything which
+  // may have changed their velocities.
+  for (index position = 0; position < total_occupied; position++)
+  {
+    const index agent = occupied[position];
+    const index entity = entities[agent];
+    const navigation_mesh *const navigation_mesh = navigation_meshes[agent];
+
+    // The entity may have been re-parented since the component was created.
+    if (entity_parent(entity) != INDEX_NONE)
+    {
+      throw(ERROR_NAVIGATION_MESH_COMPONENT_ENTITY_HAS_PARENT);
+    }
+
+    f32 *const location = next_entity_locations[entity];
+    copy_f32s(location, previous_entity_locations[entity], VECTOR_COMPONENTS);
+
+    vector remaining;
+    multiply_vector_by_scalar(navigation_mesh_component_velocities[agent], 1.0f / TICKS_PER_SECOND, remaining);
+
+    const index face = step(navigation_mesh, faces[agent], location, remaining);
+    constrain_to_surface(navigation_mesh, face, location);
+    faces[agent] = face;
+  }
+}
+
+#define NAVIGATION_MESH_COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)                           \
+  item(entities)                                      \
+  item(navigation_meshes)                             \
+  item(faces)                                         \
+  item(navigation_mesh_component_velocities)
+
+SNAPSHOT_FUNCTIONS(NAVIGATION_MESH_COMPONENT_SNAPSHOT_LIST)
+
+void capture_navigation_mesh_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_navigation_mesh_components_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+}
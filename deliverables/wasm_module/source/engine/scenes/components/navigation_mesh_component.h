@@ -1 +1,118 @@
 /** @file */
+
+#ifndef NAVIGATION_MESH_COMPONENT_H
+
+#define NAVIGATION_MESH_COMPONENT_H
+
+#include "../../primitives/index.h"
+#include "../../math/vector.h"
+#include "../../assets/navigation_mesh.h"
+#include "../../../game/project_settings/limits.h"
+#include "component.h"
+
+/**
+ * The velocity at which each navigation mesh component is to move its entity
+ * over its navigation mesh, in meters per second.
+ * @remark Defaults to zero.  Persists until changed.
+ * @remark Movement is constrained to the surface of the navigation mesh;
+ *         anything moving into a wall slides along it instead.
+ */
+extern vector navigation_mesh_component_velocities[MAXIMUM_NAVIGATION_MESH_COMPONENTS];
+
+/**
+ * Creates a new navigation mesh component as a direct child of an entity,
+ * which keeps that entity on the surface of a navigation mesh.
+ * @remark Each tick, once all tick and timer components have executed, every
+ *         navigation mesh component's entity is moved by its velocity (see
+ *         @ref navigation_mesh_component_velocities), updating its next
+ *         location and copying its next location to its previous location.
+ * @remark The entity must not have a parent, as its location is taken to be
+ *         in the same space as the navigation mesh.
+ * @remark The entity's next location should already be within the prism of the
+ *         specified face.
+ * @remark Will throw a trap should there be no navigation mesh components left
+ *         to allocate.
+ * @remark Will throw a trap should there be no components left to allocate.
+ * @remark Will throw a trap should the specified entity not exist at the time
+ *         of calling.
+ * @remark Will throw a trap should the specified face not exist.
+ * @remark Will throw a trap should the entity have a parent, either at the
+ *         time of calling or when it is next moved.
+ * @param entity The index of the entity to which to add a navigation mesh
+ *               component.
+ * @param navigation_mesh The navigation mesh to move over.
+ * @param face The index of the face of the navigation mesh which the entity is
+ *             currently within.
+ * @return A handle to the created navigation mesh component.
+ */
+component_handle navigation_mesh_component(
+    const index entity,
+    const navigation_mesh *const navigation_mesh,
+    const index face);
+
+/**
+ * Creates a new navigation mesh component as a direct child of another
+ * component, which keeps its entity on the surface of a navigation mesh.
+ * @remark Each tick, once all tick and timer components have executed, every
+ *         navigation mesh component's entity is moved by its velocity (see
+ *         @ref navigation_mesh_component_velocities), updating its next
+ *         location and copying its next location to its previous location.
+ * @remark The entity must not have a parent, as its location is taken to be
+ *         in the same space as the navigation mesh.
+ * @remark The entity's next location should already be within the prism of the
+ *         specified face.
+ * @remark Will throw a trap should there be no navigation mesh components left
+ *         to allocate.
+ * @remark Will throw a trap should there be no components left to allocate.
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @remark Will throw a trap should the specified face not exist.
+ * @remark Will throw a trap should the entity have a parent, either at the
+ *         time of calling or when it is next moved.
+ * @param component A handle to the component to which to add a navigation mesh
+ *                  component.
+ * @param navigation_mesh The navigation mesh to move over.
+ * @param face The index of the face of the navigation mesh which the entity is
+ *             currently within.
+ * @return A handle to the created navigation mesh component.
+ */
+component_handle navigation_mesh_sub_component(
+    const component_handle component,
+    const navigation_mesh *const navigation_mesh,
+    const index face);
+
+/**
+ * Determines the face of its navigation mesh which a navigation mesh component
+ * is currently within.
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @param component A handle to the navigation mesh component to check.
+ * @return The index of the face which the navigation mesh component is within.
+ */
+index navigation_mesh_component_face(const component_handle component);
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * Called by the tick event handler once to move all navigation mesh
+ * components.
+ */
+void execute_navigation_mesh_components();
+
+/**
+ * Copies the state of every navigation mesh component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_navigation_mesh_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every navigation mesh component with that in a
+ * snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_navigation_mesh_components_snapshot(const index snapshot);
+
+#endif
+
+#endif
@@ -0,0 +1,214 @@
+#include "../../primitives/index.h"
+#include "../../primitives/quantity.h"
+#include "../../primitives/s32.h"
+#include "../../miscellaneous.h"
+#include "../../../game/project_settings/limits.h"
+#include "../../exports/buffers/error.h"
+#include "../../exports/buffers/pointer.h"
+#include "../snapshot.h"
+#include "component.h"
+#include "selectable_component.h"
+
+static index occupied[MAXIMUM_SELECTABLE_COMPONENTS];
+static index positions[MAXIMUM_SELECTABLE_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
+static index last_occupied;
+static quantity total_occupied;
+
+static index entities[MAXIMUM_SELECTABLE_COMPONENTS];
+static index metas[MAXIMUM_SELECTABLE_COMPONENTS];
+static selectable_component_state states[MAXIMUM_SELECTABLE_COMPONENTS];
+static selectable_component_state_changed *on_state_changes[MAXIMUM_SELECTABLE_COMPONENTS];
+
+// The selectable component of each entity, or INDEX_NONE when it has none.
+static index selectables_of_entities[MAXIMUM_ENTITIES];
+static s32 selectables_of_entities_initialized;
+
+index selectable_component_rendering = INDEX_NONE;
+index selectable_component_picked = INDEX_NONE;
+s32 selectable_component_picking_row = INDEX_NONE;
+s32 selectable_component_picking_column = INDEX_NONE;
+
+static void initialize_selectables_of_entities()
+{
+  if (!selectables_of_entities_initialized)
+  {
+    selectables_of_entities_initialized = 1;
+
+    for (index entity = 0; entity < MAXIMUM_ENTITIES; entity++)
+    {
+      selectables_of_entities[entity] = INDEX_NONE;
+    }
+  }
+}
+
+static void destroy(const component_handle component)
+{
+  const index selectable = COMPONENT_HANDLE_META(component);
+  selectables_of_entities[entities[selectable]] = INDEX_NONE;
+
+  if (selectable_component_picked == selectable)
+  {
+    selectable_component_picked = INDEX_NONE;
+  }
+
+  INDEX_RELEASE(selectable, occupied, positions, first_occupied, last_occupied, total_occupied)
+}
+
+static index allocate(
+    const index entity,
+    const index meta,
+    selectable_component_state_changed *const on_state_changed)
+{
+  initialize_selectables_of_entities();
+
+  if (selectables_of_entities[entity] != INDEX_NONE)
+  {
+    throw(ERROR_ENTITY_ALREADY_SELECTABLE);
+  }
+
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_SELECTABLE_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_SELECTABLE_COMPONENTS_TO_ALLOCATE, selectable)
+  entities[selectable] = entity;
+  metas[selectable] = meta;
+  states[selectable] = SELECTABLE_COMPONENT_STATE_IDLE;
+  on_state_changes[selectable] = on_state_changed;
+  selectables_of_entities[entity] = selectable;
+
+  return selectable;
+}
+
+component_handle selectable_component(
+    const index entity,
+    const index meta,
+    selectable_component_state_changed *const on_state_changed)
+{
+  const index selectable = allocate(entity, meta, on_state_changed);
+  return component(entity, selectable, destroy);
+}
+
+component_handle selectable_sub_component(
+    const component_handle component,
+    const index meta,
+    selectable_component_state_changed *const on_state_changed)
+{
+  const index selectable = allocate(parent_entity_of(component), meta, on_state_changed);
+  return sub_component(component, selectable, destroy);
+}
+
+selectable_component_state selectable_component_state_of(const component_handle component)
+{
+  // Throws should the component not exist.
+  parent_entity_of(component);
+
+  return states[COMPONENT_HANDLE_META(component)];
+}
+
+index selectable_component_of_entity(const index entity)
+{
+  return selectables_of_entities_initialized ? selectables_of_entities[entity] : INDEX_NONE;
+}
+
+static selectable_component_state next_state_of(const index selectable)
+{
+  const selectable_component_state state = states[selectable];
+  const s32 hovered = pointer_state != POINTER_STATE_NONE && selectable_component_picked == selectable;
+  const s32 clicking = pointer_state == POINTER_STATE_MOUSE_CLICKING_PRIMARY;
+
+  switch (state)
+  {
+  case SELECTABLE_COMPONENT_STATE_IDLE:
+    // The primary button must be pressed after arriving, rather than dragged
+    // in from elsewhere.
+    return hovered && !clicking ? SELECTABLE_COMPONENT_STATE_HOVERING : state;
+
+  case SELECTABLE_COMPONENT_STATE_HOVERING:
+    if (!hovered)
+    {
+      return SELECTABLE_COMPONENT_STATE_IDLE;
+    }
+
+    return clicking ? SELECTABLE_COMPONENT_STATE_CONFIRMING : state;
+
+  case SELECTABLE_COMPONENT_STATE_CONFIRMING:
+    if (!hovered)
+    {
+      return SELECTABLE_COMPONENT_STATE_IDLE;
+    }
+
+    return clicking ? state : SELECTABLE_COMPONENT_STATE_SELECTED;
+
+  default:
+    return SELECTABLE_COMPONENT_STATE_IDLE;
+  }
+}
+
+void execute_selectable_components()
+{
+  // Callbacks may create or destroy selectable components, so each slot is
+  // checked for occupation as it is reached.
+  for (index selectable = 0; selectable < total_initialized; selectable++)
+  {
+    if (positions[selectable] < total_occupied)
+    {
+      const selectable_component_state state = next_state_of(selectable);
+
+      if (state != states[selectable])
+      {
+        states[selectable] = state;
+        selectable_component_state_changed *const on_state_changed = on_state_changes[selectable];
+
+        if (on_state_changed != NULL)
+        {
+          on_state_changed(metas[selectable], state);
+        }
+      }
+    }
+  }
+}
+
+s32 prepare_selectable_components_for_video()
+{
+  s32 row = INDEX_NONE;
+  s32 column = INDEX_NONE;
+
+  if (total_occupied > 0 && pointer_state != POINTER_STATE_NONE)
+  {
+    row = pointer_row;
+    column = pointer_column;
+  }
+
+  const s32 changed = row != selectable_component_picking_row || column != selectable_component_picking_column;
+  selectable_component_picking_row = row;
+  selectable_component_picking_column = column;
+  return changed;
+}
+
+#define SELECTABLE_COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)                      \
+  item(entities)                                 \
+  item(metas)                                    \
+  item(states)                                   \
+  item(on_state_changes)                         \
+  item(selectables_of_entities)                  \
+  item(selectables_of_entities_initialized)
+
+SNAPSHOT_FUNCTIONS(SELECTABLE_COMPONENT_SNAPSHOT_LIST)
+
+void capture_selectable_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_selectable_components_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+
+  // Nothing has been rendered of the restored scene yet.
+  selectable_component_picked = INDEX_NONE;
+
+  for (index selectable = 0; selectable < MAXIMUM_SELECTABLE_COMPONENTS; selectable++)
+  {
+    states[selectable] = SELECTABLE_COMPONENT_STATE_IDLE;
+  }
+}
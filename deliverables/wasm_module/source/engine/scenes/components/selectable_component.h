@@ -1 +1,179 @@
 /** @file */
+
+#ifndef SELECTABLE_COMPONENT_H
+
+#define SELECTABLE_COMPONENT_H
+
+#include "../../primitives/index.h"
+#include "../../primitives/s32.h"
+#include "component.h"
+
+/**
+ * The state of a selectable component.
+ */
+typedef s32 selectable_component_state;
+
+/**
+ * The selectable component appears inactive, but possibly interactive.
+ */
+#define SELECTABLE_COMPONENT_STATE_IDLE 0
+
+/**
+ * The pointer is hovering over the selectable component.
+ */
+#define SELECTABLE_COMPONENT_STATE_HOVERING 1
+
+/**
+ * The primary button was pressed while the pointer was hovering over the
+ * selectable component, and releasing it over the selectable component will
+ * select it.  Moving the pointer away returns the selectable component to
+ * @ref SELECTABLE_COMPONENT_STATE_IDLE.
+ */
+#define SELECTABLE_COMPONENT_STATE_CONFIRMING 2
+
+/**
+ * The selectable component was selected by the user.  Lasts for one tick, after
+ * which the selectable component returns to
+ * @ref SELECTABLE_COMPONENT_STATE_IDLE.
+ */
+#define SELECTABLE_COMPONENT_STATE_SELECTED 3
+
+/**
+ * A callback which is called when the state of a selectable component changes.
+ * @remark This can happen only during the tick event handler.
+ * @param meta The arbitrary index of the selectable component which changed
+ *             state.
+ * @param state The state which the selectable component changed to.
+ */
+typedef void(selectable_component_state_changed)(
+    index meta,
+    selectable_component_state state);
+
+/**
+ * Creates a new selectable component as a direct child of an entity.
+ * @remark The selectable component is hovered over when the pointer is over
+ *         any opaque or cutout geometry of a mesh component of the same entity,
+ *         as last rendered to the video buffer.
+ * @remark Will throw a trap should there be no selectable components left to
+ *         allocate.
+ * @remark Will throw a trap should there be no components left to allocate.
+ * @remark Will throw a trap should the specified entity not exist at the time
+ *         of calling.
+ * @remark Will throw a trap should the specified entity already have a
+ *         selectable component.
+ * @param entity The index of the entity to which to add a selectable
+ *               component.
+ * @param meta An arbitrary index which can be used to look up use-case-specific
+ *            data.
+ * @param on_state_changed Called when the state of the selectable component
+ *                         changes.  May be NULL.
+ * @return A handle to the created selectable component.
+ */
+component_handle selectable_component(
+    const index entity,
+    const index meta,
+    selectable_component_state_changed *const on_state_changed);
+
+/**
+ * Creates a new selectable component as a direct child of another component.
+ * @remark The selectable component is hovered over when the pointer is over
+ *         any opaque or cutout geometry of a mesh component of the same entity,
+ *         as last rendered to the video buffer.
+ * @remark Will throw a trap should there be no selectable components left to
+ *         allocate.
+ * @remark Will throw a trap should there be no components left to allocate.
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @remark Will throw a trap should the entity of the specified component
+ *         already have a selectable component.
+ * @param component A handle to the component to which to add a selectable
+ *                  component.
+ * @param meta An arbitrary index which can be used to look up use-case-specific
+ *            data.
+ * @param on_state_changed Called when the state of the selectable component
+ *                         changes.  May be NULL.
+ * @return A handle to the created selectable component.
+ */
+component_handle selectable_sub_component(
+    const component_handle component,
+    const index meta,
+    selectable_component_state_changed *const on_state_changed);
+
+/**
+ * Determines the current state of a selectable component.
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @param component A handle to the selectable component to check.
+ * @return The current state of the selectable component.
+ */
+selectable_component_state selectable_component_state_of(const component_handle component);
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * The selectable component of the geometry currently being rendered, or
+ * INDEX_NONE when not selectable.
+ * @remark Content is undefined except when rendering a specific camera
+ *         component.
+ */
+extern index selectable_component_rendering;
+
+/**
+ * The selectable component of the geometry last written to the pixel of the
+ * video buffer under the pointer, or INDEX_NONE when none.
+ */
+extern index selectable_component_picked;
+
+/**
+ * The number of rows between the top of the video buffer and the pixel for
+ * which to determine @ref selectable_component_picked, or INDEX_NONE when
+ * picking is not required.
+ */
+extern s32 selectable_component_picking_row;
+
+/**
+ * The number of columns between the left of the video buffer and the pixel for
+ * which to determine @ref selectable_component_picked, or INDEX_NONE when
+ * picking is not required.
+ */
+extern s32 selectable_component_picking_column;
+
+/**
+ * Determines which selectable component, if any, geometry of an entity is
+ * picked as.
+ * @param entity The index of the entity to look up.
+ * @return The selectable component of the entity, or INDEX_NONE when it has
+ *         none.
+ */
+index selectable_component_of_entity(const index entity);
+
+/**
+ * Called by the tick event handler once to update the state of all selectable
+ * components from the pointer.
+ */
+void execute_selectable_components();
+
+/**
+ * Called by the video event handler to determine which pixel to pick ahead of
+ * @ref render_camera_components.
+ * @return Non-zero when selectable components exist and the pointer is no
+ *         longer over the pixel picked by the previous render, otherwise, 0.
+ */
+s32 prepare_selectable_components_for_video();
+
+/**
+ * Copies the state of every selectable component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_selectable_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every selectable component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_selectable_components_snapshot(const index snapshot);
+
+#endif
+
+#endif
@@ -6,112 +6,194 @@
 #include "../../../game/project_settings/limits.h"
 #include "../../exports/buffers/error.h"
 #include "../../miscellaneous.h"
+#include "../snapshot.h"
 
-static index first_occupied;
+static index occupied[MAXIMUM_TICK_COMPONENTS];
+static index positions[MAXIMUM_TICK_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
 static index last_occupied;
 static quantity total_occupied;
+
+// These are stored densely in execution order; that is, sorted by phase, then
+// priority, then creation.
+static index ticks[MAXIMUM_TICK_COMPONENTS];
+static tick_component_phase phases[MAXIMUM_TICK_COMPONENTS];
+static s32 priorities[MAXIMUM_TICK_COMPONENTS];
 static tick_component_ticked *on_ticks[MAXIMUM_TICK_COMPONENTS];
 static index metas[MAXIMUM_TICK_COMPONENTS];
-static s32 delays[MAXIMUM_TICK_COMPONENTS];
+static quantity created_executions[MAXIMUM_TICK_COMPONENTS];
+
+// The position of each tick component within the above.
+static index tick_positions[MAXIMUM_TICK_COMPONENTS];
+
+// The number of times that tick components have been executed (including the
+// current execution, if any).
+static quantity executions;
 
-#define STATE_OUTSIDE_TICK_OR_AFTER_EXECUTION 0
-#define STATE_BEFORE_EXECUTION 1
-#define STATE_DURING_EXECUTION 2
+// The position of the next tick component to execute, or INDEX_NONE when not
+// executing.
+static index next_position = INDEX_NONE;
 
-static s32 state = STATE_OUTSIDE_TICK_OR_AFTER_EXECUTION;
-static index iterator;
+static void move(const index from, const index to)
+{
+  const index tick = ticks[from];
+  ticks[to] = tick;
+  phases[to] = phases[from];
+  priorities[to] = priorities[from];
+  on_ticks[to] = on_ticks[from];
+  metas[to] = metas[from];
+  created_executions[to] = created_executions[from];
+  tick_positions[tick] = to;
+}
 
 static void destroy(const component_handle component)
 {
   const index tick = COMPONENT_HANDLE_META(component);
-  on_ticks[tick] = NULL;
+  const index position = tick_positions[tick];
+
+  for (index following = position + 1; following < total_occupied; following++)
+  {
+    move(following, following - 1);
+  }
+
+  if (position < next_position)
+  {
+    next_position--;
+  }
+
+  INDEX_RELEASE(tick, occupied, positions, first_occupied, last_occupied, total_occupied)
 }
 
-static index allocate(const index meta, tick_component_ticked *const on_tick)
+static index allocate(
+    const tick_component_phase phase,
+    const s32 priority,
+    const index meta,
+    tick_component_ticked *const on_tick)
 {
-  FIND_EMPTY_INDEX(on_ticks, NULL, MAXIMUM_TICK_COMPONENTS, first_occupied, last_occupied, total_occupied, ERROR_NO_TICK_COMPONENTS_TO_ALLOCATE, tick)
-  on_ticks[tick] = on_tick;
-  metas[tick] = meta;
+  if (phase < 0 || phase >= TICK_COMPONENT_PHASES)
+  {
+    throw(ERROR_TICK_COMPONENT_PHASE_INVALID);
+  }
+
+  // Finds the position after the last tick component of the same phase and
+  // priority, so that ties execute in order of creation.
+  index lower = 0;
+  index upper = total_occupied;
 
-  switch (state)
+  while (lower < upper)
   {
-  case STATE_OUTSIDE_TICK_OR_AFTER_EXECUTION:
-    // The next time we iterate, we should execute this tick component.
-    delays[tick] = 0;
-    break;
-
-  case STATE_BEFORE_EXECUTION:
-    // We're about to iterate, so wait a tick until this execute the component
-    // we've just created.
-    delays[tick] = 1;
-    break;
-
-  case STATE_DURING_EXECUTION:
-    if (iterator >= meta)
+    const index middle = lower + (upper - lower) / 2;
+
+    if (phases[middle] < phase || (phases[middle] == phase && priorities[middle] <= priority))
     {
-      // We're currently iterating; if we've already past this index, there's
-      // effectively a delay until the next tick so don't delay further.
-      delays[tick] = 0;
+      lower = middle + 1;
     }
     else
     {
-      // Otherwise, avoid executing during this iteration with a delay.
-      delays[tick] = 1;
+      upper = middle;
     }
-    break;
+  }
+
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_TICK_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_TICK_COMPONENTS_TO_ALLOCATE, tick)
+
+  for (index following = total_occupied - 1; following > lower; following--)
+  {
+    move(following - 1, following);
+  }
+
+  ticks[lower] = tick;
+  phases[lower] = phase;
+  priorities[lower] = priority;
+  on_ticks[lower] = on_tick;
+  metas[lower] = meta;
+  tick_positions[tick] = lower;
+
+  // Tick components do not execute during the tick in which they are created,
+  // even should they be inserted ahead of the one currently executing.
+  created_executions[lower] = executions;
+
+  if (lower < next_position)
+  {
+    next_position++;
   }
 
   return tick;
 }
 
-index tick_component(
+component_handle tick_component(
     const index entity,
+    const tick_component_phase phase,
+    const s32 priority,
     const index meta,
     tick_component_ticked *const on_tick)
 {
-  const index tick = allocate(meta, on_tick);
+  const index tick = allocate(phase, priority, meta, on_tick);
   return component(entity, tick, destroy);
 }
 
 component_handle tick_sub_component(
     const component_handle component,
+    const tick_component_phase phase,
+    const s32 priority,
     const index meta,
     tick_component_ticked *const on_tick)
 {
-  const index tick = allocate(meta, on_tick);
+  const index tick = allocate(phase, priority, meta, on_tick);
   return sub_component(component, tick, destroy);
 }
 
 void before_executing_tick_components()
 {
-  state = STATE_BEFORE_EXECUTION;
+  // Anything created from here until the end of the tick belongs to this
+  // execution.
+  executions++;
 }
 
 void execute_tick_components()
 {
-  if (first_occupied != INDEX_NONE)
+  // Creating or destroying tick components during iteration shifts those which
+  // follow them, so the position of the next to execute is adjusted to match.
+  next_position = 0;
+
+  while (next_position < total_occupied)
   {
-    state = STATE_DURING_EXECUTION;
+    const index position = next_position;
+    next_position++;
 
-    for (index tick = first_occupied; tick <= last_occupied; tick++)
+    if (created_executions[position] != executions)
     {
-      tick_component_ticked *const on_tick = on_ticks[tick];
-
-      if (on_tick != NULL)
-      {
-        const s32 delay = delays[tick];
-
-        if (delay > 0)
-        {
-          delays[tick] = delay - 1;
-        }
-        else
-        {
-          on_tick(metas[tick]);
-        }
-      }
+      on_ticks[position](metas[position]);
     }
   }
 
-  state = STATE_OUTSIDE_TICK_OR_AFTER_EXECUTION;
+  next_position = INDEX_NONE;
+}
+
+#define TICK_COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)                \
+  item(ticks)                              \
+  item(phases)                             \
+  item(priorities)                         \
+  item(on_ticks)                           \
+  item(metas)                              \
+  item(tick_positions)
+
+SNAPSHOT_FUNCTIONS(TICK_COMPONENT_SNAPSHOT_LIST)
+
+void capture_tick_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_tick_components_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+
+  // As when created, restored tick components do not execute during the
+  // current tick.
+  for (index position = 0; position < total_occupied; position++)
+  {
+    created_executions[position] = executions;
+  }
 }
@@ -5,8 +5,48 @@
 #define TICK_COMPONENT_H
 
 #include "../../primitives/index.h"
+#include "../../primitives/s32.h"
 #include "component.h"
 
+/**
+ * The phase of a tick in which a tick component executes.  All tick components
+ * in one phase execute before any in the next.
+ */
+typedef s32 tick_component_phase;
+
+/**
+ * Executes first, for reacting to player input.
+ */
+#define TICK_COMPONENT_PHASE_INPUT 0
+
+/**
+ * Executes after @ref TICK_COMPONENT_PHASE_INPUT, for general game logic.
+ */
+#define TICK_COMPONENT_PHASE_LOGIC 1
+
+/**
+ * Executes after @ref TICK_COMPONENT_PHASE_LOGIC, for moving entities and
+ * resolving collisions.
+ */
+#define TICK_COMPONENT_PHASE_PHYSICS 2
+
+/**
+ * Executes after @ref TICK_COMPONENT_PHASE_PHYSICS, for animating entities
+ * once their movement is known.
+ */
+#define TICK_COMPONENT_PHASE_ANIMATION 3
+
+/**
+ * Executes last, for anything which must observe the final state of the tick,
+ * such as cameras following entities.
+ */
+#define TICK_COMPONENT_PHASE_LATE 4
+
+/**
+ * The number of tick component phases.
+ */
+#define TICK_COMPONENT_PHASES 5
+
 /**
  * A callback which is called once per tick, exclusive of the tick in which the
  * tick component was created.
@@ -17,31 +57,47 @@ typedef void(tick_component_ticked)(index meta);
 
 /**
  * Creates a new tick component as a direct child of an entity.
+ * @remark Tick components execute in order of phase, then priority, then
+ *         creation.  Giving all tick components of a type the same phase and a
+ *         priority of their own keeps their executions together.
  * @remark Will throw a trap should there be no tick components left to
  *         allocate.
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified entity not exist at the time
  *         of calling.
+ * @remark Will throw a trap should the specified phase not exist.
  * @param entity The index of the entity to which to add a tick component.
+ * @param phase The phase of each tick in which to execute.
+ * @param priority Tick components with lower priorities execute before those
+ *                 with higher priorities within the same phase.
  * @param meta An arbitrary index which can be used to look up use-case-specific
  *            data.
  * @param on_tick Called once per tick, exclusive of the tick on which the tick
  *                component was created.
  * @return A handle to the created tick component.
  */
-index tick_component(
+component_handle tick_component(
     const index entity,
+    const tick_component_phase phase,
+    const s32 priority,
     const index meta,
     tick_component_ticked *const on_tick);
 
 /**
  * Creates a new tick component as a direct child of another component.
+ * @remark Tick components execute in order of phase, then priority, then
+ *         creation.  Giving all tick components of a type the same phase and a
+ *         priority of their own keeps their executions together.
  * @remark Will throw a trap should there be no tick components left to
  *         allocate.
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified component not exist at the
  *         time of calling.
+ * @remark Will throw a trap should the specified phase not exist.
  * @param component A handle to the component to which to add a tick component.
+ * @param phase The phase of each tick in which to execute.
+ * @param priority Tick components with lower priorities execute before those
+ *                 with higher priorities within the same phase.
  * @param meta An arbitrary index which can be used to look up use-case-specific
  *            data.
  * @param on_tick Called once per tick, exclusive of the tick on which the tick
@@ -50,6 +106,8 @@ index tick_component(
  */
 component_handle tick_sub_component(
     const component_handle component,
+    const tick_component_phase phase,
+    const s32 priority,
     const index meta,
     tick_component_ticked *const on_tick);
 
@@ -65,6 +123,19 @@ void before_executing_tick_components();
  */
 void execute_tick_components();
 
+/**
+ * Copies the state of every tick component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_tick_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every tick component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_tick_components_snapshot(const index snapshot);
+
 #endif
 
 #endif
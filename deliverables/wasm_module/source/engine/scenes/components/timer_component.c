@@ -1,25 +1,193 @@
-
-
 #include "../../primitives/index.h"
 #include "../../primitives/quantity.h"
+#include "../../primitives/s32.h"
 #include "../../miscellaneous.h"
+#include "../../../game/project_settings/limits.h"
+#include "../../exports/buffers/error.h"
 #include "timer_component.h"
 #include "component.h"
+#include "../snapshot.h"
+
+// Pending timer components are kept in a hierarchical timing wheel.  Each
+// level has a bucket per value of one digit (in base TIMER_WHEEL_SLOTS) of the
+// tick on which a timer component expires.  A timer component is filed under
+// the most significant digit in which its expiry differs from the current tick,
+// and moved down a level when the current tick reaches that digit, so that each
+// is only touched a handful of times however long it runs.
+#define TIMER_WHEEL_BITS_PER_LEVEL 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS_PER_LEVEL)
+#define TIMER_WHEEL_LEVELS 6
+#define TIMER_WHEEL_BUCKETS (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+
+// An additional list, holding timer components which have expired during the
+// current tick but are yet to be destroyed.
+#define TIMER_EXPIRING_BUCKET TIMER_WHEEL_BUCKETS
+
+ASSERT(timer_wheel_covers_quantity, TIMER_WHEEL_BITS_PER_LEVEL * TIMER_WHEEL_LEVELS >= 31);
+
+static index occupied[MAXIMUM_TIMER_COMPONENTS];
+static index positions[MAXIMUM_TIMER_COMPONENTS];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
+static index last_occupied;
+static quantity total_occupied;
+
+static component_handle handles[MAXIMUM_TIMER_COMPONENTS];
+static index metas[MAXIMUM_TIMER_COMPONENTS];
+static timer_component_ticked *on_ticks[MAXIMUM_TIMER_COMPONENTS];
+static timer_component_expired *on_expiries[MAXIMUM_TIMER_COMPONENTS];
+static quantity expiry_ticks[MAXIMUM_TIMER_COMPONENTS];
+static index buckets[MAXIMUM_TIMER_COMPONENTS];
+static index previous_in_buckets[MAXIMUM_TIMER_COMPONENTS];
+static index next_in_buckets[MAXIMUM_TIMER_COMPONENTS];
+
+// The first timer component in each bucket, or INDEX_NONE when empty.
+static index bucket_heads[TIMER_WHEEL_BUCKETS + 1];
+static s32 bucket_heads_initialized;
+
+// Timer components with tick callbacks, which are stored densely so that those
+// without cost nothing per tick.
+static index ticking[MAXIMUM_TIMER_COMPONENTS];
+static index ticking_positions[MAXIMUM_TIMER_COMPONENTS];
+static quantity ticked_ticks[MAXIMUM_TIMER_COMPONENTS];
+static quantity total_ticking;
+
+// The number of the current tick, which is that of the previous tick outside
+// of the tick event handler.
+static quantity current_tick;
+
+static void initialize_bucket_heads()
+{
+  if (!bucket_heads_initialized)
+  {
+    bucket_heads_initialized = 1;
+
+    for (index bucket = 0; bucket <= TIMER_WHEEL_BUCKETS; bucket++)
+    {
+      bucket_heads[bucket] = INDEX_NONE;
+    }
+  }
+}
+
+static void link(const index timer, const index bucket)
+{
+  const index next = bucket_heads[bucket];
+  buckets[timer] = bucket;
+  previous_in_buckets[timer] = INDEX_NONE;
+  next_in_buckets[timer] = next;
+
+  if (next != INDEX_NONE)
+  {
+    previous_in_buckets[next] = timer;
+  }
+
+  bucket_heads[bucket] = timer;
+}
+
+static void unlink(const index timer)
+{
+  const index previous = previous_in_buckets[timer];
+  const index next = next_in_buckets[timer];
+
+  if (previous == INDEX_NONE)
+  {
+    bucket_heads[buckets[timer]] = next;
+  }
+  else
+  {
+    next_in_buckets[previous] = next;
+  }
+
+  if (next != INDEX_NONE)
+  {
+    previous_in_buckets[next] = previous;
+  }
+
+  buckets[timer] = INDEX_NONE;
+}
+
+static void schedule(const index timer)
+{
+  const quantity expiry = expiry_ticks[timer];
+  const quantity differing = expiry ^ current_tick;
+  index level = 0;
+
+  while (level < TIMER_WHEEL_LEVELS - 1 && differing >> (TIMER_WHEEL_BITS_PER_LEVEL * (level + 1)))
+  {
+    level++;
+  }
+
+  const index slot = (expiry >> (TIMER_WHEEL_BITS_PER_LEVEL * level)) & (TIMER_WHEEL_SLOTS - 1);
+  link(timer, level * TIMER_WHEEL_SLOTS + slot);
+}
+
+static void destroy(const component_handle component)
+{
+  const index timer = COMPONENT_HANDLE_META(component);
+
+  if (buckets[timer] != INDEX_NONE)
+  {
+    unlink(timer);
+  }
+
+  if (on_ticks[timer] != NULL)
+  {
+    const index position = ticking_positions[timer];
+    const index last = total_ticking - 1;
+    const index moved = ticking[last];
+    ticking[position] = moved;
+    ticked_ticks[position] = ticked_ticks[last];
+    ticking_positions[moved] = position;
+    total_ticking--;
+  }
+
+  INDEX_RELEASE(timer, occupied, positions, first_occupied, last_occupied, total_occupied)
+}
 
-index timer_component(
+static index allocate(
+    const index meta,
+    timer_component_ticked *const on_tick,
+    timer_component_expired *const on_expiry,
+    const quantity ticks)
+{
+  if (ticks < 1)
+  {
+    throw(ERROR_TIMER_COMPONENT_DURATION_INVALID);
+  }
+
+  initialize_bucket_heads();
+
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_TIMER_COMPONENTS, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_TIMER_COMPONENTS_TO_ALLOCATE, timer)
+  metas[timer] = meta;
+  on_ticks[timer] = on_tick;
+  on_expiries[timer] = on_expiry;
+
+  // Whether inside or outside of a tick, the next tick is the first counted.
+  expiry_ticks[timer] = current_tick + ticks;
+  schedule(timer);
+
+  if (on_tick != NULL)
+  {
+    ticking[total_ticking] = timer;
+    ticking_positions[timer] = total_ticking;
+    ticked_ticks[total_ticking] = current_tick;
+    total_ticking++;
+  }
+
+  return timer;
+}
+
+component_handle timer_component(
     const index entity,
     const index meta,
     timer_component_ticked *const on_tick,
     timer_component_expired *const on_expiry,
     const quantity ticks)
 {
-  // TODO
-  (void)(entity);
-  (void)(meta);
-  (void)(on_tick);
-  (void)(on_expiry);
-  (void)(ticks);
-  return INDEX_NONE;
+  const index timer = allocate(meta, on_tick, on_expiry, ticks);
+  const component_handle handle = component(entity, timer, destroy);
+  handles[timer] = handle;
+  return handle;
 }
 
 component_handle timer_sub_component(
@@ -29,21 +197,135 @@ component_handle timer_sub_component(
     timer_component_expired *const on_expiry,
     const quantity ticks)
 {
-  // TODO
-  (void)(component);
-  (void)(meta);
-  (void)(on_tick);
-  (void)(on_expiry);
-  (void)(ticks);
-  return INDEX_NONE;
+  const index timer = allocate(meta, on_tick, on_expiry, ticks);
+  const component_handle handle = sub_component(component, timer, destroy);
+  handles[timer] = handle;
+  return handle;
+}
+
+quantity timer_component_remaining_ticks(const component_handle component)
+{
+  // Throws should the component not exist.
+  parent_entity_of(component);
+
+  return expiry_ticks[COMPONENT_HANDLE_META(component)] - current_tick;
 }
 
 void before_executing_timer_components()
 {
-  // TODO
+  initialize_bucket_heads();
+  current_tick++;
+
+  // Moves timer components down from each level which the current tick has
+  // just reached the next digit of, highest first, as those moved down may
+  // need moving down again.
+  for (index level = TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+  {
+    if (!(current_tick & ((1 << (TIMER_WHEEL_BITS_PER_LEVEL * level)) - 1)))
+    {
+      const index bucket = level * TIMER_WHEEL_SLOTS + ((current_tick >> (TIMER_WHEEL_BITS_PER_LEVEL * level)) & (TIMER_WHEEL_SLOTS - 1));
+
+      while (bucket_heads[bucket] != INDEX_NONE)
+      {
+        const index timer = bucket_heads[bucket];
+        unlink(timer);
+        schedule(timer);
+      }
+    }
+  }
+
+  // Everything in the current slot of the lowest level expires this tick.
+  const index bucket = current_tick & (TIMER_WHEEL_SLOTS - 1);
+
+  while (bucket_heads[bucket] != INDEX_NONE)
+  {
+    const index timer = bucket_heads[bucket];
+    unlink(timer);
+    link(timer, TIMER_EXPIRING_BUCKET);
+  }
 }
 
 void execute_timer_components()
 {
-  // TODO
+  // Destroying timer components during iteration moves the last into the
+  // vacated position.  Iterating in reverse ensures that nothing unvisited is
+  // moved behind the iterator, while marking each as visited ensures that
+  // nothing is ticked twice.
+  for (index position = total_ticking - 1; position >= 0; position--)
+  {
+    if (position < total_ticking && ticked_ticks[position] != current_tick)
+    {
+      ticked_ticks[position] = current_tick;
+      const index timer = ticking[position];
+      on_ticks[timer](metas[timer]);
+    }
+  }
+
+  // Anything destroyed by the above will have been removed from this list.
+  while (bucket_heads[TIMER_EXPIRING_BUCKET] != INDEX_NONE)
+  {
+    const index timer = bucket_heads[TIMER_EXPIRING_BUCKET];
+    const index meta = metas[timer];
+    timer_component_expired *const on_expiry = on_expiries[timer];
+    unlink(timer);
+    destroy_component(handles[timer]);
+
+    if (on_expiry != NULL)
+    {
+      on_expiry(meta);
+    }
+  }
+}
+
+// The wheel itself is rebuilt on restore, as everything in it is relative to
+// the current tick.
+#define TIMER_COMPONENT_SNAPSHOT_LIST(item) \
+  SNAPSHOT_INDEX_POOL(item)                 \
+  item(handles)                             \
+  item(metas)                               \
+  item(on_ticks)                            \
+  item(on_expiries)                         \
+  item(expiry_ticks)                        \
+  item(ticking)                             \
+  item(ticking_positions)                   \
+  item(total_ticking)                       \
+  item(current_tick)
+
+SNAPSHOT_FUNCTIONS(TIMER_COMPONENT_SNAPSHOT_LIST)
+
+void capture_timer_components_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_timer_components_snapshot(const index snapshot)
+{
+  const quantity restored_tick = current_tick;
+  restore_snapshot(snapshot);
+
+  // Each timer component resumes with the number of ticks it had remaining
+  // when captured.
+  const quantity elapsed_ticks = restored_tick - current_tick;
+  current_tick = restored_tick;
+
+  for (index bucket = 0; bucket <= TIMER_WHEEL_BUCKETS; bucket++)
+  {
+    bucket_heads[bucket] = INDEX_NONE;
+  }
+
+  bucket_heads_initialized = 1;
+
+  for (index position = 0; position < total_occupied; position++)
+  {
+    const index timer = occupied[position];
+    expiry_ticks[timer] += elapsed_ticks;
+    schedule(timer);
+  }
+
+  // As when created, restored timer components do not tick during the current
+  // tick.
+  for (index position = 0; position < total_ticking; position++)
+  {
+    ticked_ticks[position] = current_tick;
+  }
 }
@@ -34,6 +34,7 @@ typedef void(timer_component_expired)(index meta);
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified entity not exist at the time
  *         of calling.
+ * @remark Will throw a trap should the duration be less than 1 tick.
  * @param entity The index of the entity to which to add a timer component.
  * @param meta An arbitrary index which can be used to look up use-case-specific
  *            data.
@@ -49,7 +50,7 @@ typedef void(timer_component_expired)(index meta);
  *              1.
  * @return A handle to the created timer component.
  */
-index timer_component(
+component_handle timer_component(
     const index entity,
     const index meta,
     timer_component_ticked *const on_tick,
@@ -63,6 +64,7 @@ index timer_component(
  * @remark Will throw a trap should there be no components left to allocate.
  * @remark Will throw a trap should the specified component not exist at the
  *         time of calling.
+ * @remark Will throw a trap should the duration be less than 1 tick.
  * @param component A handle to the component to which to add a timer component.
  * @param meta An arbitrary index which can be used to look up use-case-specific
  *            data.
@@ -85,10 +87,24 @@ component_handle timer_sub_component(
     timer_component_expired *const on_expiry,
     const quantity ticks);
 
+/**
+ * Determines how many more ticks a timer component will run for.  As callbacks
+ * cannot be persisted, games which need timers to survive being saved and
+ * loaded can store this in a state buffer and create a replacement timer
+ * component with it as the duration when next entering the scene.
+ * @remark Will throw a trap should the specified component not exist at the
+ *         time of calling.
+ * @param component A handle to the timer component to query.
+ * @return The number of ticks remaining, including the tick on which the timer
+ *         component will expire.
+ */
+quantity timer_component_remaining_ticks(const component_handle component);
+
 #ifndef DOXYGEN_IGNORE
 
 /**
- * Called at the very start of the tick event handler.
+ * Called at the very start of the tick event handler to advance the timing
+ * wheel.
  */
 void before_executing_timer_components();
 
@@ -97,6 +113,19 @@ void before_executing_timer_components();
  */
 void execute_timer_components();
 
+/**
+ * Copies the state of every timer component into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_timer_components_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every timer component with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_timer_components_snapshot(const index snapshot);
+
 #endif
 
 #endif
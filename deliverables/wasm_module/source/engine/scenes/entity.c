@@ -1,51 +1,220 @@
 #include "../primitives/index.h"
 #include "../primitives/s32.h"
+#include "../primitives/f32.h"
 #include "../math/matrix.h"
+#include "../math/vector.h"
+#include "../math/float.h"
+#include "../math/trigonometry.h"
+#include "../miscellaneous.h"
 #include "../../game/project_settings/limits.h"
 #include "components/component.h"
 #include "../exports/buffers/error.h"
 #include "../exports/buffers/video.h"
 #include "components/camera_component.h"
+#include "snapshot.h"
+#include "spatial_index.h"
 
-matrix previous_entity_transforms[MAXIMUM_ENTITIES];
-matrix next_entity_transforms[MAXIMUM_ENTITIES];
+vector previous_entity_locations[MAXIMUM_ENTITIES];
+vector next_entity_locations[MAXIMUM_ENTITIES];
+vector previous_entity_rotations[MAXIMUM_ENTITIES];
+vector next_entity_rotations[MAXIMUM_ENTITIES];
+vector previous_entity_scales[MAXIMUM_ENTITIES];
+vector next_entity_scales[MAXIMUM_ENTITIES];
 matrix interpolated_entity_transforms[MAXIMUM_ENTITIES];
-matrix previous_inverse_entity_transforms[MAXIMUM_ENTITIES];
-matrix next_inverse_entity_transforms[MAXIMUM_ENTITIES];
 matrix interpolated_inverse_entity_transforms[MAXIMUM_ENTITIES];
 matrix entity_model_view_projections[MAXIMUM_ENTITIES];
 matrix inverse_entity_model_view_projections[MAXIMUM_ENTITIES];
+s32 entity_layers[MAXIMUM_ENTITIES];
 
 #define ENTITY_STATE_INACTIVE 0
 #define ENTITY_STATE_ACTIVE 1
 #define ENTITY_STATE_DELETING 2
 
 static s32 states[MAXIMUM_ENTITIES];
+static s32 rendered_entity_layers[MAXIMUM_ENTITIES];
+static quantity renderable_references[MAXIMUM_ENTITIES];
+static quantity inverse_model_view_projection_references[MAXIMUM_ENTITIES];
+static index renderable_entities[MAXIMUM_ENTITIES];
+static index renderable_entity_positions[MAXIMUM_ENTITIES];
+static quantity total_renderable_entities;
+static vector interpolated_locations[MAXIMUM_ENTITIES];
+static vector interpolated_rotations[MAXIMUM_ENTITIES];
+static vector interpolated_scales[MAXIMUM_ENTITIES];
+static s32 stale[MAXIMUM_ENTITIES];
+static s32 moving[MAXIMUM_ENTITIES];
+static s32 changed[MAXIMUM_ENTITIES];
+static s32 needed[MAXIMUM_ENTITIES];
+static quantity inverse_references[MAXIMUM_ENTITIES];
+static s32 stale_inverses[MAXIMUM_ENTITIES];
+static s32 destructions_deferred[MAXIMUM_ENTITIES];
 
-static index first_occupied;
+// The entities marked through destructions_deferred, stored densely so that
+// only they are visited.
+static index deferred_entities[MAXIMUM_ENTITIES];
+static index deferred_entity_positions[MAXIMUM_ENTITIES];
+static quantity total_destructions_deferred;
+
+// The entities (and so their descendants) to be re-filed into the spatial index
+// at the start of the next tick, each listed once.
+static s32 relocated[MAXIMUM_ENTITIES];
+static index relocated_entities[MAXIMUM_ENTITIES];
+static quantity total_relocated;
+
+// The transforms, relative to their parents, at which entities were last filed
+// into the spatial index, compared against their next transforms at the start
+// of each tick to detect movement.
+static vector filed_locations[MAXIMUM_ENTITIES];
+static vector filed_rotations[MAXIMUM_ENTITIES];
+static vector filed_scales[MAXIMUM_ENTITIES];
+
+// The entities whose transforms are rebuilt during the current video render, in
+// the same order as ordered, gathered so that their local matrices can be
+// calculated as a batch.
+static index rebuilt[MAXIMUM_ENTITIES];
+static vector rebuilt_locations[MAXIMUM_ENTITIES];
+static vector rebuilt_rotations[MAXIMUM_ENTITIES];
+static vector rebuilt_scales[MAXIMUM_ENTITIES];
+static matrix rebuilt_transforms[MAXIMUM_ENTITIES];
+
+static index parents[MAXIMUM_ENTITIES];
+static index first_children[MAXIMUM_ENTITIES];
+static index previous_siblings[MAXIMUM_ENTITIES];
+static index next_siblings[MAXIMUM_ENTITIES];
+
+// Every entity, with parents always before their children.  This is rebuilt
+// when entities are destroyed or re-parented.
+static index ordered[MAXIMUM_ENTITIES];
+static quantity total_ordered;
+static s32 ordered_stale;
+
+// Set whenever scripts may have modified the previous and/or next transforms of
+// any entity, so that which are moving during the tick can be re-determined.
+static s32 motion_stale = 1;
+
+static index occupied[MAXIMUM_ENTITIES];
+static index positions[MAXIMUM_ENTITIES];
+static quantity total_initialized;
+static index first_occupied = INDEX_NONE;
 static index last_occupied;
 static quantity total_occupied;
 
+static void link(const index entity, const index parent)
+{
+  parents[entity] = parent;
+
+  if (parent != INDEX_NONE)
+  {
+    const index next_sibling = first_children[parent];
+    previous_siblings[entity] = INDEX_NONE;
+    next_siblings[entity] = next_sibling;
+
+    if (next_sibling != INDEX_NONE)
+    {
+      previous_siblings[next_sibling] = entity;
+    }
+
+    first_children[parent] = entity;
+  }
+}
+
+static void unlink(const index entity)
+{
+  const index parent = parents[entity];
+
+  if (parent != INDEX_NONE)
+  {
+    const index previous_sibling = previous_siblings[entity];
+    const index next_sibling = next_siblings[entity];
+
+    if (previous_sibling == INDEX_NONE)
+    {
+      first_children[parent] = next_sibling;
+    }
+    else
+    {
+      next_siblings[previous_sibling] = next_sibling;
+    }
+
+    if (next_sibling != INDEX_NONE)
+    {
+      previous_siblings[next_sibling] = previous_sibling;
+    }
+  }
+}
+
+static void mark_relocated(const index entity)
+{
+  if (!relocated[entity])
+  {
+    relocated[entity] = 1;
+    relocated_entities[total_relocated] = entity;
+    total_relocated++;
+  }
+}
+
 index entity()
 {
-  FIND_EMPTY_INDEX(states, ENTITY_STATE_INACTIVE, MAXIMUM_ENTITIES, first_occupied, last_occupied, total_occupied, ERROR_NO_ENTITIES_TO_ALLOCATE, entity)
+  INDEX_ALLOCATE(occupied, positions, MAXIMUM_ENTITIES, total_initialized, first_occupied, last_occupied, total_occupied, ERROR_NO_ENTITIES_TO_ALLOCATE, entity)
 
   states[entity] = ENTITY_STATE_ACTIVE;
-  copy_matrix(identity_matrix, previous_entity_transforms[entity]);
-  copy_matrix(identity_matrix, next_entity_transforms[entity]);
-  copy_matrix(identity_matrix, previous_inverse_entity_transforms[entity]);
-  copy_matrix(identity_matrix, next_inverse_entity_transforms[entity]);
+  initialize_components_of(entity);
+  copy_f32(0.0f, previous_entity_locations[entity], VECTOR_COMPONENTS);
+  copy_f32(0.0f, next_entity_locations[entity], VECTOR_COMPONENTS);
+  copy_f32(0.0f, previous_entity_rotations[entity], VECTOR_COMPONENTS);
+  copy_f32(0.0f, next_entity_rotations[entity], VECTOR_COMPONENTS);
+  copy_f32(1.0f, previous_entity_scales[entity], VECTOR_COMPONENTS);
+  copy_f32(1.0f, next_entity_scales[entity], VECTOR_COMPONENTS);
+  stale[entity] = 1;
+  stale_inverses[entity] = 1;
+  first_children[entity] = INDEX_NONE;
+  link(entity, INDEX_NONE);
+  mark_relocated(entity);
+
+  // As this has no parent, it can go last without breaking the ordering.
+  if (!ordered_stale)
+  {
+    ordered[total_ordered] = entity;
+    total_ordered++;
+  }
 
   return entity;
 }
 
+void reserve_entities(const quantity quantity)
+{
+  if (quantity > MAXIMUM_ENTITIES - total_occupied)
+  {
+    throw(ERROR_NO_ENTITIES_TO_ALLOCATE);
+  }
+}
+
 void destroy_entity(const index entity)
 {
   if (states[entity] == ENTITY_STATE_ACTIVE)
   {
     states[entity] = ENTITY_STATE_DELETING;
+
+    if (destructions_deferred[entity])
+    {
+      destructions_deferred[entity] = 0;
+      total_destructions_deferred--;
+      const index moved = deferred_entities[total_destructions_deferred];
+      const index position = deferred_entity_positions[entity];
+      deferred_entities[position] = moved;
+      deferred_entity_positions[moved] = position;
+    }
+
+    while (first_children[entity] != INDEX_NONE)
+    {
+      destroy_entity(first_children[entity]);
+    }
+
     destroy_all_components_of(entity);
-    INDEX_VACATE(entity, states, ENTITY_STATE_INACTIVE, first_occupied, last_occupied, total_occupied)
+    remove_entity_from_spatial_index(entity);
+    unlink(entity);
+    ordered_stale = 1;
+    states[entity] = ENTITY_STATE_INACTIVE;
+    INDEX_RELEASE(entity, occupied, positions, first_occupied, last_occupied, total_occupied)
   }
   else
   {
@@ -53,12 +222,137 @@ void destroy_entity(const index entity)
   }
 }
 
+void defer_entity_destruction(const index entity)
+{
+  if (states[entity] != ENTITY_STATE_ACTIVE)
+  {
+    throw(ERROR_ENTITY_DOES_NOT_EXIST);
+  }
+
+  if (!destructions_deferred[entity])
+  {
+    destructions_deferred[entity] = 1;
+    deferred_entities[total_destructions_deferred] = entity;
+    deferred_entity_positions[entity] = total_destructions_deferred;
+    total_destructions_deferred++;
+  }
+}
+
+void destroy_deferred_entities()
+{
+  // Each destruction removes itself (and anything else it destroys) from the
+  // list, so this always ends.
+  while (total_destructions_deferred > 0)
+  {
+    destroy_entity(deferred_entities[total_destructions_deferred - 1]);
+  }
+}
+
+#define ENTITY_SNAPSHOT_LIST(item)               \
+  SNAPSHOT_INDEX_POOL(item)                      \
+  item(states)                                   \
+  item(previous_entity_locations)                \
+  item(next_entity_locations)                    \
+  item(previous_entity_rotations)                \
+  item(next_entity_rotations)                    \
+  item(previous_entity_scales)                   \
+  item(next_entity_scales)                       \
+  item(renderable_references)                    \
+  item(inverse_model_view_projection_references) \
+  item(renderable_entities)                      \
+  item(renderable_entity_positions)              \
+  item(total_renderable_entities)                \
+  item(inverse_references)                       \
+  item(destructions_deferred)                    \
+  item(deferred_entities)                        \
+  item(deferred_entity_positions)                \
+  item(total_destructions_deferred)              \
+  item(parents)                                  \
+  item(first_children)                           \
+  item(previous_siblings)                        \
+  item(next_siblings)                            \
+  item(ordered)                                  \
+  item(total_ordered)                            \
+  item(ordered_stale)
+
+SNAPSHOT_FUNCTIONS(ENTITY_SNAPSHOT_LIST)
+
+void capture_entities_snapshot(const index snapshot)
+{
+  capture_snapshot(snapshot);
+}
+
+void restore_entities_snapshot(const index snapshot)
+{
+  restore_snapshot(snapshot);
+
+  // Nothing derived for video was captured, so everything is rebuilt.
+  for (index entity = 0; entity < MAXIMUM_ENTITIES; entity++)
+  {
+    stale[entity] = 1;
+    stale_inverses[entity] = 1;
+  }
+
+  motion_stale = 1;
+
+  for (index position = 0; position < total_occupied; position++)
+  {
+    mark_relocated(occupied[position]);
+  }
+}
+
+void set_entity_parent(
+    const index entity,
+    const index parent)
+{
+  if (states[entity] != ENTITY_STATE_ACTIVE || (parent != INDEX_NONE && states[parent] != ENTITY_STATE_ACTIVE))
+  {
+    throw(ERROR_ENTITY_DOES_NOT_EXIST);
+  }
+
+  for (index ancestor = parent; ancestor != INDEX_NONE; ancestor = parents[ancestor])
+  {
+    if (ancestor == entity)
+    {
+      throw(ERROR_ENTITY_PARENT_CYCLE);
+    }
+  }
+
+  unlink(entity);
+  link(entity, parent);
+  stale[entity] = 1;
+  ordered_stale = 1;
+  mark_relocated(entity);
+}
+
+index entity_parent(const index entity)
+{
+  if (states[entity] != ENTITY_STATE_ACTIVE)
+  {
+    throw(ERROR_ENTITY_DOES_NOT_EXIST);
+  }
+
+  return parents[entity];
+}
+
+void relocate_entity(const index entity)
+{
+  if (states[entity] != ENTITY_STATE_ACTIVE)
+  {
+    throw(ERROR_ENTITY_DOES_NOT_EXIST);
+  }
+
+  mark_relocated(entity);
+}
+
 void destroy_all_entities()
 {
-  if (first_occupied != INDEX_NONE)
+  for (index position = total_occupied - 1; position >= 0; position--)
   {
-    for (index entity = first_occupied; entity <= last_occupied; entity++)
+    if (position < total_occupied)
     {
+      const index entity = occupied[position];
+
       if (states[entity] == ENTITY_STATE_ACTIVE)
       {
         destroy_entity(entity);
@@ -67,67 +361,404 @@ void destroy_all_entities()
   }
 }
 
-static void prepare_entity_column_for_video(
+static s32 interpolate_entity_column_for_video(
     const f32 *const previous,
     const f32 *const next,
     f32 *const interpolated,
     const quantity total)
 {
+  s32 changed = 0;
+
   for (index index = 0; index < total; index++)
   {
-    interpolated[index] = tick_progress * next[index] + inverse_tick_progress * previous[index];
+    const f32 value = tick_progress * next[index] + inverse_tick_progress * previous[index];
+    changed |= value != interpolated[index];
+    interpolated[index] = value;
   }
+
+  return changed;
 }
 
-void prepare_entities_for_video()
+// Rotations take the shortest way around, so that one which wraps (such as
+// from 3.1 to -3.1 radians) does not spin the long way for a tick.
+static s32 interpolate_entity_rotation_for_video(
+    const f32 *const previous,
+    const f32 *const next,
+    f32 *const interpolated)
 {
-  if (first_occupied != INDEX_NONE)
+  s32 changed = 0;
+
+  for (index index = 0; index < VECTOR_COMPONENTS; index++)
   {
-    const quantity total = (1 + last_occupied - first_occupied) * 16;
+    const f32 delta = next[index] - previous[index];
+    const f32 wrapped = delta - 2.0f * PI * floor((delta + PI) / (2.0f * PI));
+    const f32 value = previous[index] + tick_progress * wrapped;
+    changed |= value != interpolated[index];
+    interpolated[index] = value;
+  }
 
-    prepare_entity_column_for_video(
-        &previous_entity_transforms[first_occupied][0][0],
-        &next_entity_transforms[first_occupied][0][0],
-        &interpolated_entity_transforms[first_occupied][0][0],
-        total);
+  return changed;
+}
 
-    prepare_entity_column_for_video(
-        &previous_inverse_entity_transforms[first_occupied][0][0],
-        &next_inverse_entity_transforms[first_occupied][0][0],
-        &interpolated_inverse_entity_transforms[first_occupied][0][0],
-        total);
+static s32 copy_entity_column_for_video(
+    const f32 *const next,
+    f32 *const interpolated,
+    const quantity total)
+{
+  s32 changed = 0;
+
+  for (index index = 0; index < total; index++)
+  {
+    const f32 value = next[index];
+    changed |= value != interpolated[index];
+    interpolated[index] = value;
   }
+
+  return changed;
 }
 
-static void apply_current_camera_component_to_column_of_entity_transforms(
-    const matrix *const interpolated_transforms,
-    matrix from_camera_component,
-    matrix *const applied_transforms,
+static s32 entity_column_moving(
+    const f32 *const previous,
+    const f32 *const next,
     const quantity total)
 {
   for (index index = 0; index < total; index++)
   {
-    // TODO: Check whether this is correct for inverse, it likely isn't.
-    multiply_matrices(from_camera_component, interpolated_transforms[index], applied_transforms[index]);
+    if (previous[index] != next[index])
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static s32 prepare_entity_locals_for_video(const index entity)
+{
+  if (motion_stale || stale[entity])
+  {
+    moving[entity] = entity_column_moving(previous_entity_locations[entity], next_entity_locations[entity], VECTOR_COMPONENTS) || entity_column_moving(previous_entity_rotations[entity], next_entity_rotations[entity], VECTOR_COMPONENTS) || entity_column_moving(previous_entity_scales[entity], next_entity_scales[entity], VECTOR_COMPONENTS);
+
+    if (!moving[entity])
+    {
+      // Static entities are copied once per tick, and then left alone until
+      // the next.
+      s32 changed = copy_entity_column_for_video(next_entity_locations[entity], interpolated_locations[entity], VECTOR_COMPONENTS);
+      changed |= copy_entity_column_for_video(next_entity_rotations[entity], interpolated_rotations[entity], VECTOR_COMPONENTS);
+      changed |= copy_entity_column_for_video(next_entity_scales[entity], interpolated_scales[entity], VECTOR_COMPONENTS);
+      return changed;
+    }
+  }
+  else if (!moving[entity])
+  {
+    return 0;
+  }
+
+  s32 changed = interpolate_entity_column_for_video(previous_entity_locations[entity], next_entity_locations[entity], interpolated_locations[entity], VECTOR_COMPONENTS);
+  changed |= interpolate_entity_rotation_for_video(previous_entity_rotations[entity], next_entity_rotations[entity], interpolated_rotations[entity]);
+  changed |= interpolate_entity_column_for_video(previous_entity_scales[entity], next_entity_scales[entity], interpolated_scales[entity], VECTOR_COMPONENTS);
+  return changed;
+}
+
+// Files an entity and all of its descendants into the spatial index at their
+// locations in world space, given the world transform of its parent (or NULL
+// should it have none).
+static void index_entity_spatially(
+    const index entity,
+    const matrix parent_transform)
+{
+  relocated[entity] = 0;
+  copy_f32s(next_entity_locations[entity], filed_locations[entity], VECTOR_COMPONENTS);
+  copy_f32s(next_entity_rotations[entity], filed_rotations[entity], VECTOR_COMPONENTS);
+  copy_f32s(next_entity_scales[entity], filed_scales[entity], VECTOR_COMPONENTS);
+
+  if (parent_transform == NULL && first_children[entity] == INDEX_NONE)
+  {
+    place_entity_in_spatial_index(entity, next_entity_locations[entity]);
+    return;
+  }
+
+  matrix transform;
+  model(next_entity_locations[entity], next_entity_rotations[entity], next_entity_scales[entity], transform, NULL);
+
+  if (parent_transform != NULL)
+  {
+    multiply_affine_matrices(parent_transform, transform, transform);
+  }
+
+  const vector location = {transform[0][3], transform[1][3], transform[2][3]};
+  place_entity_in_spatial_index(entity, location);
+
+  for (index child = first_children[entity]; child != INDEX_NONE; child = next_siblings[child])
+  {
+    index_entity_spatially(child, transform);
+  }
+}
+
+void index_entities_spatially()
+{
+  // Rotations and scales only move descendants, so are only compared for
+  // entities which have any.
+  for (index position = 0; position < total_occupied; position++)
+  {
+    const index entity = occupied[position];
+
+    if (!relocated[entity] && (entity_column_moving(filed_locations[entity], next_entity_locations[entity], VECTOR_COMPONENTS) || (first_children[entity] != INDEX_NONE && (entity_column_moving(filed_rotations[entity], next_entity_rotations[entity], VECTOR_COMPONENTS) || entity_column_moving(filed_scales[entity], next_entity_scales[entity], VECTOR_COMPONENTS)))))
+    {
+      mark_relocated(entity);
+    }
+  }
+
+  for (index position = 0; position < total_relocated; position++)
+  {
+    const index entity = relocated_entities[position];
+
+    // Anything destroyed since was removed at the time, and anything under an
+    // ancestor listed before it has already been re-filed.
+    if (states[entity] != ENTITY_STATE_ACTIVE || !relocated[entity])
+    {
+      relocated[entity] = 0;
+      continue;
+    }
+
+    const index parent = parents[entity];
+
+    if (parent == INDEX_NONE)
+    {
+      index_entity_spatially(entity, NULL);
+    }
+    else
+    {
+      matrix parent_transform;
+      model(next_entity_locations[parent], next_entity_rotations[parent], next_entity_scales[parent], parent_transform, NULL);
+
+      for (index ancestor = parents[parent]; ancestor != INDEX_NONE; ancestor = parents[ancestor])
+      {
+        matrix ancestor_transform;
+        model(next_entity_locations[ancestor], next_entity_rotations[ancestor], next_entity_scales[ancestor], ancestor_transform, NULL);
+        multiply_affine_matrices(ancestor_transform, parent_transform, parent_transform);
+      }
+
+      index_entity_spatially(entity, parent_transform);
+    }
+  }
+
+  total_relocated = 0;
+}
+
+void invalidate_entity_motion()
+{
+  motion_stale = 1;
+}
+
+void reference_inverse_entity_transform(const index entity)
+{
+  inverse_references[entity]++;
+}
+
+void dereference_inverse_entity_transform(const index entity)
+{
+  inverse_references[entity]--;
+}
+
+void reference_renderable_entity(
+    const index entity,
+    const s32 needs_inverse)
+{
+  if (renderable_references[entity]++ == 0)
+  {
+    renderable_entity_positions[entity] = total_renderable_entities;
+    renderable_entities[total_renderable_entities] = entity;
+    total_renderable_entities++;
+  }
+
+  if (needs_inverse)
+  {
+    inverse_model_view_projection_references[entity]++;
+    reference_inverse_entity_transform(entity);
   }
 }
 
+void dereference_renderable_entity(
+    const index entity,
+    const s32 needs_inverse)
+{
+  if (needs_inverse)
+  {
+    inverse_model_view_projection_references[entity]--;
+    dereference_inverse_entity_transform(entity);
+  }
+
+  if (--renderable_references[entity] == 0)
+  {
+    total_renderable_entities--;
+    const index position = renderable_entity_positions[entity];
+    const index moved = renderable_entities[total_renderable_entities];
+    renderable_entities[position] = moved;
+    renderable_entity_positions[moved] = position;
+    entity_layers[entity] = 0;
+  }
+}
+
+void clear_entity_layers()
+{
+  for (index renderable = 0; renderable < total_renderable_entities; renderable++)
+  {
+    entity_layers[renderable_entities[renderable]] = 0;
+  }
+}
+
+static void order_entities()
+{
+  total_ordered = 0;
+
+  for (index position = 0; position < total_occupied; position++)
+  {
+    const index entity = occupied[position];
+
+    if (parents[entity] == INDEX_NONE)
+    {
+      ordered[total_ordered] = entity;
+      total_ordered++;
+    }
+  }
+
+  // Breadth-first, so that each entity's children are appended after it.
+  for (index position = 0; position < total_ordered; position++)
+  {
+    for (index child = first_children[ordered[position]]; child != INDEX_NONE; child = next_siblings[child])
+    {
+      ordered[total_ordered] = child;
+      total_ordered++;
+    }
+  }
+
+  ordered_stale = 0;
+}
+
+s32 prepare_entities_for_video()
+{
+  s32 changed_layers = 0;
+  quantity total_rebuilt = 0;
+
+  if (ordered_stale)
+  {
+    order_entities();
+  }
+
+  // Only entities which are rendered, or have descendants which are, need world
+  // transforms.  Walking in reverse visits children before their parents.
+  for (index position = total_ordered - 1; position >= 0; position--)
+  {
+    const index entity = ordered[position];
+
+    if (needed[entity] || renderable_references[entity] || inverse_references[entity])
+    {
+      needed[entity] = 1;
+
+      const index parent = parents[entity];
+
+      if (parent != INDEX_NONE)
+      {
+        needed[parent] = 1;
+      }
+    }
+  }
+
+  for (index position = 0; position < total_ordered; position++)
+  {
+    const index entity = ordered[position];
+
+    if (needed[entity])
+    {
+      needed[entity] = 0;
+
+      const index parent = parents[entity];
+
+      const s32 entity_changed = prepare_entity_locals_for_video(entity) || stale[entity] || (parent != INDEX_NONE && changed[parent]);
+      changed[entity] = entity_changed;
+      stale[entity] = 0;
+
+      if (entity_changed)
+      {
+        copy_f32s(interpolated_locations[entity], rebuilt_locations[total_rebuilt], VECTOR_COMPONENTS);
+        copy_f32s(interpolated_rotations[entity], rebuilt_rotations[total_rebuilt], VECTOR_COMPONENTS);
+        copy_f32s(interpolated_scales[entity], rebuilt_scales[total_rebuilt], VECTOR_COMPONENTS);
+        rebuilt[total_rebuilt] = entity;
+        total_rebuilt++;
+      }
+    }
+    else
+    {
+      // Nothing will read this entity's transforms, so defer the work until
+      // something does.
+      changed[entity] = 0;
+      stale[entity] = 1;
+    }
+
+    const s32 layers = entity_layers[entity];
+    const s32 previous_layers = rendered_entity_layers[entity];
+
+    if (changed[entity] || layers != previous_layers)
+    {
+      changed_layers |= layers | previous_layers;
+    }
+
+    rendered_entity_layers[entity] = layers;
+  }
+
+  motion_stale = 0;
+
+  models(rebuilt_locations, rebuilt_rotations, rebuilt_scales, rebuilt_transforms, total_rebuilt);
+
+  // As rebuilt follows the hierarchy, parents are always complete before their
+  // children are composed onto them.
+  for (index position = 0; position < total_rebuilt; position++)
+  {
+    const index entity = rebuilt[position];
+    const index parent = parents[entity];
+
+    if (parent == INDEX_NONE)
+    {
+      copy_matrix(rebuilt_transforms[position], interpolated_entity_transforms[entity]);
+    }
+    else
+    {
+      multiply_affine_matrices(interpolated_entity_transforms[parent], rebuilt_transforms[position], interpolated_entity_transforms[entity]);
+    }
+
+    stale_inverses[entity] = 1;
+  }
+
+  for (index position = 0; position < total_ordered; position++)
+  {
+    const index entity = ordered[position];
+
+    if (stale_inverses[entity] && inverse_references[entity])
+    {
+      invert_affine_matrix(interpolated_entity_transforms[entity], interpolated_inverse_entity_transforms[entity]);
+      stale_inverses[entity] = 0;
+    }
+  }
+
+  return changed_layers;
+}
+
 void apply_current_camera_component_to_entity_transforms()
 {
-  if (first_occupied != INDEX_NONE)
+  for (index renderable = 0; renderable < total_renderable_entities; renderable++)
   {
-    const quantity total = 1 + last_occupied - first_occupied;
+    const index entity = renderable_entities[renderable];
 
-    apply_current_camera_component_to_column_of_entity_transforms(
-        &interpolated_entity_transforms[first_occupied],
-        camera_component_view_projection,
-        &entity_model_view_projections[first_occupied],
-        total);
+    if (entity_layers[entity] & camera_component_culling_mask)
+    {
+      multiply_matrix_by_affine_matrix(camera_component_view_projection, interpolated_entity_transforms[entity], entity_model_view_projections[entity]);
 
-    apply_current_camera_component_to_column_of_entity_transforms(
-        &interpolated_inverse_entity_transforms[first_occupied],
-        camera_component_inverse_view_projection,
-        &inverse_entity_model_view_projections[first_occupied],
-        total);
+      if (inverse_model_view_projection_references[entity])
+      {
+        // TODO: Check whether this is correct for inverse, it likely isn't.
+        multiply_matrix_by_affine_matrix(camera_component_inverse_view_projection, interpolated_inverse_entity_transforms[entity], inverse_entity_model_view_projections[entity]);
+      }
+    }
   }
 }
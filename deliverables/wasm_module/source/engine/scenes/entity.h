@@ -5,12 +5,15 @@
 #define ENTITY_H
 
 #include "../primitives/index.h"
+#include "../primitives/s32.h"
+#include "../primitives/quantity.h"
 #include "../math/matrix.h"
+#include "../math/vector.h"
 #include "../../game/project_settings/limits.h"
 #include "components/camera_component.h"
 
 /**
- * Creates a new entity with a default identity transform.
+ * Creates a new entity at the origin, without rotation, at a scale of 1.
  * @remark Call only during scripts or the tick event handler (doing so in other
  *         situations may produce unexpected results).
  * @remark Will throw a trap should there be no entities left to allocate.
@@ -19,71 +22,111 @@
 index entity();
 
 /**
- * The forward transforms of all entities at the start of the tick.
+ * The locations of all entities at the start of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none.
  * @remark Modify only during scripts or the tick event handler (doing so in
  *         other situations may produce unexpected results).
- * @remark Any changes made to this array MUST be mirrored in
- *         @ref previous_inverse_entity_transforms.
  */
-extern matrix previous_entity_transforms[MAXIMUM_ENTITIES];
+extern vector previous_entity_locations[MAXIMUM_ENTITIES];
 
 /**
- * The forward transforms of all entities at the end of the tick.
+ * The locations of all entities at the end of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none.
  * @remark Modify only during scripts or the tick event handler (doing so in
  *         other situations may produce unexpected results).
- * @remark Any changes made to this array MUST be mirrored in
- *         @ref next_inverse_entity_transforms.
  */
-extern matrix next_entity_transforms[MAXIMUM_ENTITIES];
+extern vector next_entity_locations[MAXIMUM_ENTITIES];
 
 /**
- * The inverse transforms of all entities at the start of the tick.
+ * The rotations of all entities at the start of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none, as XYZ Euler angles in radians.
  * @remark Modify only during scripts or the tick event handler (doing so in
  *         other situations may produce unexpected results).
- * @remark Any changes made to this array MUST be mirrored in
- *         @ref previous_entity_transforms.
  */
-extern matrix previous_inverse_entity_transforms[MAXIMUM_ENTITIES];
+extern vector previous_entity_rotations[MAXIMUM_ENTITIES];
 
 /**
- * The inverse transforms of all entities at the end of the tick.
+ * The rotations of all entities at the end of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none, as XYZ Euler angles in radians.
  * @remark Modify only during scripts or the tick event handler (doing so in
  *         other situations may produce unexpected results).
- * @remark Any changes made to this array MUST be mirrored in
- *         @ref next_entity_transforms.
  */
-extern matrix next_inverse_entity_transforms[MAXIMUM_ENTITIES];
+extern vector next_entity_rotations[MAXIMUM_ENTITIES];
+
+/**
+ * The scales of all entities at the start of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none, as multiplying factors.
+ * @remark Modify only during scripts or the tick event handler (doing so in
+ *         other situations may produce unexpected results).
+ */
+extern vector previous_entity_scales[MAXIMUM_ENTITIES];
+
+/**
+ * The scales of all entities at the end of the tick, relative to their
+ * parent entities (see @ref set_entity_parent) or the world should they have
+ * none, as multiplying factors.
+ * @remark Modify only during scripts or the tick event handler (doing so in
+ *         other situations may produce unexpected results).
+ */
+extern vector next_entity_scales[MAXIMUM_ENTITIES];
 
 #ifndef DOXYGEN_IGNORE
 
+/**
+ * Checks that a number of entities can be created.
+ * @remark Will throw a trap should there not be enough entities left to
+ *         allocate.
+ * @param quantity The number of entities which are about to be created.
+ */
+void reserve_entities(const quantity quantity);
+
 /**
  * The forward transforms of all entities at the time of the current video
- * render.
+ * render, relative to the world.
+ * @remark Only recalculated when an entity's own transform or that of one of
+ *         its ancestors changes.
  */
 extern matrix interpolated_entity_transforms[MAXIMUM_ENTITIES];
 
 /**
  * The inverse transforms of all entities at the time of the current video
- * render.
+ * render, relative to the world.
+ * @remark Only populated for entities referenced through
+ *         @ref reference_inverse_entity_transform.
  */
 extern matrix interpolated_inverse_entity_transforms[MAXIMUM_ENTITIES];
 
 /**
  * The forward model-view-projection matrices of all entities at the time of the
  * current video render.
+ * @remark See @ref reference_renderable_entity.
  */
 extern matrix entity_model_view_projections[MAXIMUM_ENTITIES];
 
 /**
  * The inverse model-view-projection matrices of all entities at the time of the
  * current video render.
+ * @remark See @ref reference_renderable_entity.
  */
 extern matrix inverse_entity_model_view_projections[MAXIMUM_ENTITIES];
 
+/**
+ * The layers on which each entity has renderable components during the current
+ * video render, as a bit mask.  Accumulated by renderable component types
+ * between @ref clear_entity_layers and @ref prepare_entities_for_video.
+ */
+extern s32 entity_layers[MAXIMUM_ENTITIES];
+
 #endif
 
 /**
- * Destroys a previously created entity and all components within it.
+ * Destroys a previously created entity, all components within it and all of
+ * its child entities.
  * @remark Call only during scripts or the tick event handler (doing so in other
  *         situations may produce unexpected results).
  * @remark Will throw a trap should the specified entity not exist at the time
@@ -95,6 +138,69 @@ extern matrix inverse_entity_model_view_projections[MAXIMUM_ENTITIES];
  */
 void destroy_entity(const index entity);
 
+/**
+ * Marks a previously created entity to be destroyed (as though by
+ * @ref destroy_entity) at the end of the current tick, or the next should this
+ * be called outside of one.  Deferred destructions are applied together, in
+ * order of entity index, after all tick and timer components have been
+ * executed, which avoids disturbing them mid-execution.
+ * @remark Call only during scripts or the tick event handler (doing so in other
+ *         situations may produce unexpected results).
+ * @remark Will throw a trap should the specified entity not exist at the time
+ *         of calling.
+ * @remark The entity continues to exist until then; calling this multiple times
+ *         has no further effect.  Should it be destroyed by any other means
+ *         first, nothing further happens.
+ * @param entity The index of the entity to destroy.
+ */
+void defer_entity_destruction(const index entity);
+
+/**
+ * Attaches an entity to another, so that its transform becomes relative to
+ * that of its new parent, or detaches it so that its transform becomes
+ * relative to the world.
+ * @remark Call only during scripts or the tick event handler (doing so in other
+ *         situations may produce unexpected results).
+ * @remark Destroying an entity also destroys all of its child entities.
+ * @remark Its transforms are not modified, so it will jump should its new
+ *         parent not be at the same location, rotation and scale as its
+ *         previous parent.
+ * @remark Will throw a trap should either entity not exist at the time of
+ *         calling.
+ * @remark Will throw a trap should the parent be the entity itself or one of
+ *         its descendants.
+ * @param entity The index of the entity to attach or detach.
+ * @param parent The index of the entity to attach it to, or INDEX_NONE to
+ *               detach it.
+ */
+void set_entity_parent(
+    const index entity,
+    const index parent);
+
+/**
+ * Determines the parent of an entity.
+ * @remark Will throw a trap should the entity not exist at the time of calling.
+ * @param entity The index of the entity to check.
+ * @return The index of the entity's parent (see @ref set_entity_parent), or
+ *         INDEX_NONE should it have none.
+ */
+index entity_parent(const index entity);
+
+/**
+ * Marks an entity as having moved, so that it (and all of its descendants) are
+ * re-filed for @ref entities_within_radius, @ref entities_within_bounds and
+ * @ref nearest_entities at the start of the next tick.
+ * @remark Calling this is optional; changes to @ref next_entity_locations, and
+ *         to the @ref next_entity_rotations and @ref next_entity_scales of
+ *         entities with children, are detected at the start of each tick, and
+ *         entities which are created or re-parented are marked automatically.
+ * @remark Call only during scripts or the tick event handler (doing so in other
+ *         situations may produce unexpected results).
+ * @remark Will throw a trap should the entity not exist at the time of calling.
+ * @param entity The index of the entity which moved.
+ */
+void relocate_entity(const index entity);
+
 /**
  * Destroys a previously created entities and all components within them.
  * @remark Call only during scripts or the tick event handler (doing so in other
@@ -104,10 +210,93 @@ void destroy_all_entities();
 
 #ifndef DOXYGEN_IGNORE
 
+/**
+ * Registers a renderable component within an entity, so that model-view-
+ * projection matrices are calculated for it.
+ * @param entity The index of the entity containing the renderable component.
+ * @param needs_inverse Non-zero when the component additionally requires
+ *                      @ref inverse_entity_model_view_projections, otherwise,
+ *                      0.
+ */
+void reference_renderable_entity(
+    const index entity,
+    const s32 needs_inverse);
+
+/**
+ * Reverses a previous call to @ref reference_renderable_entity.
+ * @param entity The index of the entity containing the renderable component.
+ * @param needs_inverse The value previously given to
+ *                      @ref reference_renderable_entity.
+ */
+void dereference_renderable_entity(
+    const index entity,
+    const s32 needs_inverse);
+
+/**
+ * Requests that @ref interpolated_inverse_entity_transforms be populated for
+ * an entity from the next video render onward.
+ * @param entity The index of the entity for which inverse transforms are
+ *               required.
+ */
+void reference_inverse_entity_transform(const index entity);
+
+/**
+ * Reverses a previous call to @ref reference_inverse_entity_transform.
+ * @param entity The index of the entity for which inverse transforms are no
+ *               longer required.
+ */
+void dereference_inverse_entity_transform(const index entity);
+
+/**
+ * Called during the video event handler to zero @ref entity_layers ahead of
+ * renderable component types accumulating into it.
+ */
+void clear_entity_layers();
+
+/**
+ * Called at the start of the tick event handler to bring the spatial index up
+ * to date with the world space locations of all entities which have moved,
+ * been created, been re-parented or been passed to @ref relocate_entity since
+ * the last, and their descendants.
+ */
+void index_entities_spatially();
+
+/**
+ * Called at the end of the tick event handler to destroy all entities marked
+ * through @ref defer_entity_destruction.
+ */
+void destroy_deferred_entities();
+
+/**
+ * Copies the state of every entity into a snapshot.
+ * @param snapshot The index of the snapshot to copy into.
+ */
+void capture_entities_snapshot(const index snapshot);
+
+/**
+ * Replaces the state of every entity with that in a snapshot.
+ * @remark Call only once all entities have been destroyed.
+ * @param snapshot The index of the snapshot to copy from.
+ */
+void restore_entities_snapshot(const index snapshot);
+
+/**
+ * Called at the end of the tick event handler to indicate that the previous
+ * and/or next transforms of any entity may have been modified, so that
+ * @ref prepare_entities_for_video re-determines which are moving rather than
+ * static.
+ */
+void invalidate_entity_motion();
+
 /**
  * Called during the video event handler to perform interpolation as required.
+ * @remark Only entities whose previous and next transforms differ are
+ *         interpolated; static entities are copied once per tick.
+ * @return A bit mask of the layers on which an entity's interpolated transform
+ *         or @ref entity_layers differs from that of the previous video event
+ *         handler.
  */
-void prepare_entities_for_video();
+s32 prepare_entities_for_video();
 
 /**
  * Populates @ref entity_model_view_projections and
@@ -115,6 +304,10 @@ void prepare_entities_for_video();
  * @ref camera_component_view_projection to @ref interpolated_entity_transforms
  * and @ref camera_component_inverse_view_projection to
  * @ref interpolated_inverse_entity_transforms respectively.
+ * @remark Only entities referenced through @ref reference_renderable_entity
+ *         with @ref entity_layers in common with
+ *         @ref camera_component_culling_mask are populated, and only those
+ *         referenced as needing them have inverses populated.
  */
 void apply_current_camera_component_to_entity_transforms();
 
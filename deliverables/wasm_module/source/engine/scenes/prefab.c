@@ -0,0 +1,126 @@
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../primitives/s32.h"
+#include "../primitives/f32.h"
+#include "../math/vector.h"
+#include "../miscellaneous.h"
+#include "entity.h"
+#include "prefab.h"
+#include "components/component.h"
+#include "components/mesh_component.h"
+#include "components/camera_component.h"
+#include "../assets/mesh.h"
+#include "../exports/buffers/error.h"
+#include "../../game/project_settings/limits.h"
+
+// The entities of the instances currently being created, stacked so that a
+// custom prefab_component_factory may itself instantiate prefabs.
+static index instantiated[MAXIMUM_ENTITIES];
+static quantity total_instantiated;
+
+// Multiplies a count per instance by the number of instances, throwing should
+// that exceed the size of the pool (which could otherwise wrap around).
+static quantity across_instances(
+    const quantity per_instance,
+    const quantity instances,
+    const quantity maximum,
+    const s32 error)
+{
+  if (per_instance > 0 && instances > maximum / per_instance)
+  {
+    throw(error);
+  }
+
+  return per_instance * instances;
+}
+
+void prefab_mesh_component(
+    const index entity,
+    const void *const argument)
+{
+  mesh_component(entity, argument);
+}
+
+void prefab_camera_component(
+    const index entity,
+    const void *const argument)
+{
+  (void)(argument);
+  camera_component(entity);
+}
+
+void instantiate_prefab(
+    const prefab *const prefab,
+    const index parent,
+    const quantity instances,
+    index *const created)
+{
+  const quantity entities = prefab->entities;
+
+  // Checked up-front so that a prefab is never partially instantiated by
+  // running out part-way.  Only the factories provided by the engine are known
+  // to use specific pools.
+  quantity meshes = 0;
+  quantity opaque_cutout_meshes = 0;
+  quantity additive_blended_meshes = 0;
+  quantity cameras = 0;
+
+  for (index prefab_component = 0; prefab_component < prefab->components; prefab_component++)
+  {
+    prefab_component_factory *const factory = prefab->component_factories[prefab_component];
+
+    if (factory == prefab_mesh_component)
+    {
+      const mesh *const mesh = prefab->component_arguments[prefab_component];
+      meshes++;
+      opaque_cutout_meshes += mesh->opaque_cutout_vertices != 0;
+      additive_blended_meshes += mesh->additive_blended_vertices != 0;
+    }
+    else if (factory == prefab_camera_component)
+    {
+      cameras++;
+    }
+  }
+
+  reserve_entities(across_instances(entities, instances, MAXIMUM_ENTITIES, ERROR_NO_ENTITIES_TO_ALLOCATE));
+  reserve_components(across_instances(prefab->components, instances, MAXIMUM_COMPONENTS, ERROR_NO_COMPONENTS_TO_ALLOCATE));
+  reserve_mesh_components(across_instances(meshes, instances, MAXIMUM_MESH_COMPONENTS, ERROR_NO_MESH_COMPONENTS_TO_ALLOCATE), across_instances(opaque_cutout_meshes, instances, MAXIMUM_OPAQUE_CUTOUT_MESH_COMPONENTS, ERROR_NO_OPAQUE_CUTOUT_MESH_COMPONENTS_TO_ALLOCATE), across_instances(additive_blended_meshes, instances, MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS, ERROR_NO_ADDITIVE_BLENDED_MESH_COMPONENTS_TO_ALLOCATE));
+  reserve_camera_components(across_instances(cameras, instances, MAXIMUM_CAMERA_COMPONENTS, ERROR_NO_CAMERA_COMPONENTS_TO_ALLOCATE));
+
+  // Every entity in the stack exists, so it cannot outgrow the entity pool.
+  index *const scratch = &instantiated[total_instantiated];
+  total_instantiated += created == NULL ? entities : 0;
+
+  for (index instance = 0; instance < instances; instance++)
+  {
+    index *const instance_entities = created == NULL ? scratch : &created[instance * entities];
+
+    for (index prefab_entity = 0; prefab_entity < entities; prefab_entity++)
+    {
+      const index entity_index = entity();
+      instance_entities[prefab_entity] = entity_index;
+
+      copy_f32s(prefab->locations[prefab_entity], previous_entity_locations[entity_index], VECTOR_COMPONENTS);
+      copy_f32s(prefab->locations[prefab_entity], next_entity_locations[entity_index], VECTOR_COMPONENTS);
+      copy_f32s(prefab->rotations[prefab_entity], previous_entity_rotations[entity_index], VECTOR_COMPONENTS);
+      copy_f32s(prefab->rotations[prefab_entity], next_entity_rotations[entity_index], VECTOR_COMPONENTS);
+      copy_f32s(prefab->scales[prefab_entity], previous_entity_scales[entity_index], VECTOR_COMPONENTS);
+      copy_f32s(prefab->scales[prefab_entity], next_entity_scales[entity_index], VECTOR_COMPONENTS);
+
+      const index prefab_parent = prefab->parents[prefab_entity];
+      const index instance_parent = prefab_parent == INDEX_NONE ? parent : instance_entities[prefab_parent];
+
+      if (instance_parent != INDEX_NONE)
+      {
+        set_entity_parent(entity_index, instance_parent);
+      }
+    }
+
+    for (index prefab_component = 0; prefab_component < prefab->components; prefab_component++)
+    {
+      prefab->component_factories[prefab_component](instance_entities[prefab->component_entities[prefab_component]], prefab->component_arguments[prefab_component]);
+    }
+  }
+
+  total_instantiated -= created == NULL ? entities : 0;
+}
@@ -0,0 +1,116 @@
+/** @file */
+
+#ifndef PREFAB_H
+
+#define PREFAB_H
+
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../math/vector.h"
+
+/**
+ * Adds a component to an entity instantiated from a prefab.
+ * @param entity The index of the entity to which to add a component.
+ * @param argument The argument given alongside this in the prefab, whose
+ *                 meaning is specific to the factory.
+ */
+typedef void(prefab_component_factory)(
+    const index entity,
+    const void *const argument);
+
+/**
+ * An immutable description of a tree of entities and their components, which
+ * can be instantiated any number of times through @ref instantiate_prefab.
+ */
+typedef struct
+{
+  /**
+   * The number of entities within the prefab.
+   */
+  const quantity entities;
+
+  /**
+   * For each entity, the index of its parent entity within the prefab, or
+   * INDEX_NONE should it be attached to the parent given to
+   * @ref instantiate_prefab.  Parents must precede their children.
+   */
+  const index *const parents;
+
+  /**
+   * For each entity, its location relative to its parent.
+   */
+  const vector *const locations;
+
+  /**
+   * For each entity, its rotation relative to its parent, as XYZ Euler angles
+   * in radians.
+   */
+  const vector *const rotations;
+
+  /**
+   * For each entity, its scale relative to its parent, as multiplying factors.
+   */
+  const vector *const scales;
+
+  /**
+   * The number of components within the prefab.
+   */
+  const quantity components;
+
+  /**
+   * For each component, the index of the entity within the prefab to which it
+   * is to be added.
+   */
+  const index *const component_entities;
+
+  /**
+   * For each component, the factory which adds it to its entity.
+   */
+  prefab_component_factory *const *const component_factories;
+
+  /**
+   * For each component, the argument to give to its factory.
+   */
+  const void *const *const component_arguments;
+} prefab;
+
+/**
+ * A @ref prefab_component_factory which adds a mesh component, where the
+ * argument is a pointer to the mesh to display.
+ */
+prefab_component_factory prefab_mesh_component;
+
+/**
+ * A @ref prefab_component_factory which adds a camera component, where the
+ * argument is ignored.
+ */
+prefab_component_factory prefab_camera_component;
+
+/**
+ * Creates copies of all entities and components within a prefab.
+ * @remark Call only during scripts or the tick event handler (doing so in other
+ *         situations may produce unexpected results).
+ * @remark Will throw a trap, before creating anything, should there not be
+ *         enough entities, components, or mesh or camera components (for
+ *         @ref prefab_mesh_component and @ref prefab_camera_component) left to
+ *         allocate.  This is only a check made up-front; instances are still
+ *         created one entity and component at a time, so anything else which
+ *         a custom @ref prefab_component_factory allocates may run out
+ *         part-way through.
+ * @remark Will throw a trap should the specified parent not exist at the time
+ *         of calling.
+ * @param prefab The prefab to instantiate.
+ * @param parent The index of the entity to attach the instances to, or
+ *               INDEX_NONE to leave them unattached.
+ * @param instances The number of copies to create.
+ * @param created Written with the indices of all created entities, instance by
+ *                instance, in the order they appear in the prefab.  May be
+ *                @ref NULL.
+ */
+void instantiate_prefab(
+    const prefab *const prefab,
+    const index parent,
+    const quantity instances,
+    index *const created);
+
+#endif
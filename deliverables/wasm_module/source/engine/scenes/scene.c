@@ -1,14 +1,122 @@
 #include "../../game/scripts/scripts.h"
+#include "../../game/project_settings/limits.h"
 #include "../exports/buffers/persist.h"
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../primitives/s32.h"
 #include "scene.h"
 #include "entity.h"
+#include "components/component.h"
+#include "components/mesh_component.h"
+#include "components/camera_component.h"
+#include "components/tick_component.h"
+#include "components/timer_component.h"
+#include "components/selectable_component.h"
+#include "components/navigation_mesh_component.h"
+
+static script snapshot_scripts[MAXIMUM_SCENE_SNAPSHOTS];
+
+// The value of entries at the time each snapshot was last used, or 0 should it
+// be empty.
+static quantity snapshot_entries[MAXIMUM_SCENE_SNAPSHOTS];
+static quantity entries;
+
+static s32 snapshot_requested;
+
+static index find_snapshot(const script script)
+{
+  for (index snapshot = 0; snapshot < MAXIMUM_SCENE_SNAPSHOTS; snapshot++)
+  {
+    if (snapshot_entries[snapshot] && snapshot_scripts[snapshot] == script)
+    {
+      return snapshot;
+    }
+  }
+
+  return INDEX_NONE;
+}
+
+static index least_recently_entered_snapshot()
+{
+  index least_recent = 0;
+
+  for (index snapshot = 1; snapshot < MAXIMUM_SCENE_SNAPSHOTS; snapshot++)
+  {
+    if (snapshot_entries[snapshot] < snapshot_entries[least_recent])
+    {
+      least_recent = snapshot;
+    }
+  }
+
+  return least_recent;
+}
+
+static void capture_scene(const script script)
+{
+  const index snapshot = least_recently_entered_snapshot();
+  capture_entities_snapshot(snapshot);
+  capture_components_snapshot(snapshot);
+  capture_mesh_components_snapshot(snapshot);
+  capture_camera_components_snapshot(snapshot);
+  capture_tick_components_snapshot(snapshot);
+  capture_timer_components_snapshot(snapshot);
+  capture_selectable_components_snapshot(snapshot);
+  capture_navigation_mesh_components_snapshot(snapshot);
+  snapshot_scripts[snapshot] = script;
+  snapshot_entries[snapshot] = entries;
+}
+
+static void restore_scene(const index snapshot)
+{
+  restore_entities_snapshot(snapshot);
+  restore_components_snapshot(snapshot);
+  restore_mesh_components_snapshot(snapshot);
+  restore_camera_components_snapshot(snapshot);
+  restore_tick_components_snapshot(snapshot);
+  restore_timer_components_snapshot(snapshot);
+  restore_selectable_components_snapshot(snapshot);
+  restore_navigation_mesh_components_snapshot(snapshot);
+  snapshot_entries[snapshot] = entries;
+}
 
 void enter(const script script)
 {
   destroy_all_entities();
   current_script = script;
-  script_body(script);
+  entries++;
+
+  const index snapshot = find_snapshot(script);
+
+  if (snapshot == INDEX_NONE)
+  {
+    snapshot_requested = 0;
+    script_body(script);
+
+    if (snapshot_requested)
+    {
+      snapshot_requested = 0;
+      capture_scene(script);
+    }
+  }
+  else
+  {
+    restore_scene(snapshot);
+  }
+
   persist_state();
 }
 
+void snapshot_scene()
+{
+  snapshot_requested = 1;
+}
+
+void discard_scene_snapshots()
+{
+  for (index snapshot = 0; snapshot < MAXIMUM_SCENE_SNAPSHOTS; snapshot++)
+  {
+    snapshot_entries[snapshot] = 0;
+  }
+}
+
 script current_script = SCRIPT_START;
@@ -7,7 +7,8 @@
 
 /**
  * Destroys all entities in the scene, calls @ref persist_state, then executes
- * the specified script.
+ * the specified script (or restores the snapshot taken of it through
+ * @ref snapshot_scene, should one exist).
  * @remark Call only during scripts or the tick event handler (doing so in other
  *         situations may produce unexpected results).
  * @remark Will throw a trap should the specified script not be recognized.
@@ -22,4 +23,28 @@ void enter(const script script);
  */
 extern script current_script;
 
+/**
+ * Requests that the scene built by the script currently being executed be kept
+ * as a snapshot once the script returns, so that entering the same script
+ * again restores that snapshot rather than executing the script.
+ * @remark Call only during scripts (it has no effect in other situations).
+ * @remark Up to @ref MAXIMUM_SCENE_SNAPSHOTS snapshots are kept, after which
+ *         the snapshot of the script least recently entered is replaced.
+ * @remark Only the entities and components of the scene are restored; nothing
+ *         which the script wrote elsewhere (such as game state) is.  Entity
+ *         indices and component handles are restored exactly, so any the
+ *         script stored remain valid, but any from other scenes must not be
+ *         kept.
+ * @remark Restored tick and timer components behave as though created during
+ *         the current tick, and timer components resume with the number of
+ *         ticks which they had remaining when the script returned.
+ */
+void snapshot_scene();
+
+/**
+ * Discards all snapshots kept through @ref snapshot_scene, so that the next
+ * entry into each script executes it again.
+ */
+void discard_scene_snapshots();
+
 #endif
@@ -0,0 +1,33 @@
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "snapshot.h"
+
+char *capture_snapshot_bytes(
+    const void *const variable,
+    char *const destination,
+    const quantity size)
+{
+  const char *const source = variable;
+
+  for (index byte = 0; byte < size; byte++)
+  {
+    destination[byte] = source[byte];
+  }
+
+  return destination + size;
+}
+
+const char *restore_snapshot_bytes(
+    const char *const source,
+    void *const variable,
+    const quantity size)
+{
+  char *const destination = variable;
+
+  for (index byte = 0; byte < size; byte++)
+  {
+    destination[byte] = source[byte];
+  }
+
+  return source + size;
+}
@@ -0,0 +1,77 @@
+/** @file */
+
+#ifndef SNAPSHOT_H
+
+#define SNAPSHOT_H
+
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../../game/project_settings/limits.h"
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * Copies the bytes of a variable into a snapshot.
+ * @param variable The variable to copy from.
+ * @param destination The snapshot to copy into.
+ * @param size The size of the variable, in bytes.
+ * @return The location in the snapshot immediately following that copied to.
+ */
+char *capture_snapshot_bytes(
+    const void *const variable,
+    char *const destination,
+    const quantity size);
+
+/**
+ * Copies the bytes of a variable out of a snapshot.
+ * @param source The snapshot to copy from.
+ * @param variable The variable to copy into.
+ * @param size The size of the variable, in bytes.
+ * @return The location in the snapshot immediately following that copied from.
+ */
+const char *restore_snapshot_bytes(
+    const char *const source,
+    void *const variable,
+    const quantity size);
+
+#define SNAPSHOT_SIZE_OF(variable) +sizeof(variable)
+#define SNAPSHOT_CAPTURE(variable) destination = capture_snapshot_bytes(&(variable), destination, sizeof(variable));
+#define SNAPSHOT_RESTORE(variable) source = restore_snapshot_bytes(source, &(variable), sizeof(variable));
+
+/**
+ * Lists the variables which make up a pool of indices allocated through
+ * @ref INDEX_ALLOCATE, for inclusion in a snapshot.
+ * @param item The X-macro to apply to each variable.
+ */
+#define SNAPSHOT_INDEX_POOL(item) \
+  item(occupied)                  \
+  item(positions)                 \
+  item(total_initialized)         \
+  item(first_occupied)            \
+  item(last_occupied)             \
+  item(total_occupied)
+
+/**
+ * Defines storage for snapshots of a list of variables, and static functions
+ * named capture_snapshot and restore_snapshot which copy them into and out of
+ * a given snapshot by index.
+ * @param list An X-macro listing the variables to include.
+ */
+#define SNAPSHOT_FUNCTIONS(list)                                            \
+  static char snapshots[MAXIMUM_SCENE_SNAPSHOTS][0 list(SNAPSHOT_SIZE_OF)]; \
+                                                                            \
+  static void capture_snapshot(const index snapshot)                        \
+  {                                                                         \
+    char *destination = snapshots[snapshot];                                \
+    list(SNAPSHOT_CAPTURE)                                                  \
+  }                                                                         \
+                                                                            \
+  static void restore_snapshot(const index snapshot)                        \
+  {                                                                         \
+    const char *source = snapshots[snapshot];                               \
+    list(SNAPSHOT_RESTORE)                                                  \
+  }
+
+#endif
+
+#endif
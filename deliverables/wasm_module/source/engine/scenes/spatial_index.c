@@ -0,0 +1,365 @@
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../primitives/s32.h"
+#include "../primitives/f32.h"
+#include "../math/vector.h"
+#include "../math/float.h"
+#include "../math/relational.h"
+#include "../miscellaneous.h"
+#include "../../game/project_settings/limits.h"
+#include "../../game/project_settings/spatial_index_settings.h"
+#include "spatial_index.h"
+
+// Entities are filed into buckets by the cell containing their location.  Cells
+// wrap around every SPATIAL_INDEX_CELLS_PER_AXIS along each axis, so that an
+// unbounded grid needs only a fixed number of buckets; entities in a bucket may
+// therefore be in any of the cells sharing it, and are tested individually.
+#define SPATIAL_INDEX_AXIS_MASK (SPATIAL_INDEX_CELLS_PER_AXIS - 1)
+#define SPATIAL_INDEX_BUCKETS (SPATIAL_INDEX_CELLS_PER_AXIS * SPATIAL_INDEX_CELLS_PER_AXIS * SPATIAL_INDEX_CELLS_PER_AXIS)
+
+// Cells further than this from the origin are clamped, so that very distant
+// locations cannot overflow.
+#define SPATIAL_INDEX_FURTHEST_CELL 1048576
+
+ASSERT(spatial_index_cells_per_axis_power_of_two, SPATIAL_INDEX_CELLS_PER_AXIS > 0 && (SPATIAL_INDEX_CELLS_PER_AXIS & SPATIAL_INDEX_AXIS_MASK) == 0);
+
+static s32 indexed[MAXIMUM_ENTITIES];
+static vector locations[MAXIMUM_ENTITIES];
+static index buckets[MAXIMUM_ENTITIES];
+static index previous_in_buckets[MAXIMUM_ENTITIES];
+static index next_in_buckets[MAXIMUM_ENTITIES];
+
+// The first entity in each bucket, or INDEX_NONE when empty.
+static index bucket_heads[SPATIAL_INDEX_BUCKETS];
+static s32 bucket_heads_initialized;
+
+// Indexed entities are also stored densely, to be scanned instead of buckets
+// when a query covers more cells than there are entities.
+static index indexed_entities[MAXIMUM_ENTITIES];
+static index indexed_entity_positions[MAXIMUM_ENTITIES];
+static quantity total_indexed;
+
+// Used to find the nearest entities; each entity is stamped with the query
+// which last considered it.
+static quantity queries;
+static quantity considered_queries[MAXIMUM_ENTITIES];
+static f32 nearest_squared_distances[MAXIMUM_ENTITIES];
+
+static void initialize_bucket_heads()
+{
+  if (!bucket_heads_initialized)
+  {
+    bucket_heads_initialized = 1;
+
+    for (index bucket = 0; bucket < SPATIAL_INDEX_BUCKETS; bucket++)
+    {
+      bucket_heads[bucket] = INDEX_NONE;
+    }
+  }
+}
+
+static s32 cell_of(const f32 coordinate)
+{
+  const f32 cell = floor(coordinate / SPATIAL_INDEX_CELL_SIZE);
+  return CLAMP(cell, -SPATIAL_INDEX_FURTHEST_CELL, SPATIAL_INDEX_FURTHEST_CELL);
+}
+
+static index bucket_of(const s32 x, const s32 y, const s32 z)
+{
+  return ((x & SPATIAL_INDEX_AXIS_MASK) * SPATIAL_INDEX_CELLS_PER_AXIS + (y & SPATIAL_INDEX_AXIS_MASK)) * SPATIAL_INDEX_CELLS_PER_AXIS + (z & SPATIAL_INDEX_AXIS_MASK);
+}
+
+static void link(const index entity, const index bucket)
+{
+  const index next = bucket_heads[bucket];
+  buckets[entity] = bucket;
+  previous_in_buckets[entity] = INDEX_NONE;
+  next_in_buckets[entity] = next;
+
+  if (next != INDEX_NONE)
+  {
+    previous_in_buckets[next] = entity;
+  }
+
+  bucket_heads[bucket] = entity;
+}
+
+static void unlink(const index entity)
+{
+  const index previous = previous_in_buckets[entity];
+  const index next = next_in_buckets[entity];
+
+  if (previous == INDEX_NONE)
+  {
+    bucket_heads[buckets[entity]] = next;
+  }
+  else
+  {
+    next_in_buckets[previous] = next;
+  }
+
+  if (next != INDEX_NONE)
+  {
+    previous_in_buckets[next] = previous;
+  }
+}
+
+void place_entity_in_spatial_index(
+    const index entity,
+    const vector location)
+{
+  initialize_bucket_heads();
+  copy_f32s(location, locations[entity], VECTOR_COMPONENTS);
+
+  const index bucket = bucket_of(cell_of(location[0]), cell_of(location[1]), cell_of(location[2]));
+
+  if (indexed[entity])
+  {
+    if (buckets[entity] == bucket)
+    {
+      return;
+    }
+
+    unlink(entity);
+  }
+  else
+  {
+    indexed[entity] = 1;
+    indexed_entities[total_indexed] = entity;
+    indexed_entity_positions[entity] = total_indexed;
+    total_indexed++;
+  }
+
+  link(entity, bucket);
+}
+
+void remove_entity_from_spatial_index(const index entity)
+{
+  if (indexed[entity])
+  {
+    indexed[entity] = 0;
+    unlink(entity);
+
+    total_indexed--;
+    const index moved = indexed_entities[total_indexed];
+    const index position = indexed_entity_positions[entity];
+    indexed_entities[position] = moved;
+    indexed_entity_positions[moved] = position;
+  }
+}
+
+static f32 squared_distance_to(const index entity, const vector location)
+{
+  vector difference;
+  subtract_vectors(locations[entity], location, difference);
+  return dot_product(difference, difference);
+}
+
+static s32 matches(
+    const index entity,
+    const vector minimum,
+    const vector maximum,
+    const vector center,
+    const f32 squared_radius)
+{
+  const f32 *const location = locations[entity];
+
+  return location[0] >= minimum[0] && location[0] <= maximum[0] && location[1] >= minimum[1] && location[1] <= maximum[1] && location[2] >= minimum[2] && location[2] <= maximum[2] && squared_distance_to(entity, center) <= squared_radius;
+}
+
+static quantity search(
+    const vector minimum,
+    const vector maximum,
+    const vector center,
+    const f32 squared_radius,
+    index *const entities,
+    const quantity maximum_entities)
+{
+  s32 first_cells[VECTOR_COMPONENTS];
+  s32 last_cells[VECTOR_COMPONENTS];
+  quantity total_cells = 1;
+
+  for (index axis = 0; axis < VECTOR_COMPONENTS; axis++)
+  {
+    const s32 first_cell = cell_of(minimum[axis]);
+    const s32 last_cell = cell_of(maximum[axis]);
+
+    if (last_cell < first_cell)
+    {
+      return 0;
+    }
+
+    // Beyond this, further cells would share buckets with those already
+    // searched.
+    const quantity cells = MIN(1 + last_cell - first_cell, SPATIAL_INDEX_CELLS_PER_AXIS);
+    first_cells[axis] = first_cell;
+    last_cells[axis] = first_cell + cells - 1;
+    total_cells *= cells;
+  }
+
+  quantity found = 0;
+
+  if (total_cells > total_indexed)
+  {
+    for (index position = 0; position < total_indexed && found < maximum_entities; position++)
+    {
+      const index entity = indexed_entities[position];
+
+      if (matches(entity, minimum, maximum, center, squared_radius))
+      {
+        entities[found] = entity;
+        found++;
+      }
+    }
+  }
+  else
+  {
+    for (s32 x = first_cells[0]; x <= last_cells[0] && found < maximum_entities; x++)
+    {
+      for (s32 y = first_cells[1]; y <= last_cells[1] && found < maximum_entities; y++)
+      {
+        for (s32 z = first_cells[2]; z <= last_cells[2] && found < maximum_entities; z++)
+        {
+          for (index entity = bucket_heads[bucket_of(x, y, z)]; entity != INDEX_NONE && found < maximum_entities; entity = next_in_buckets[entity])
+          {
+            if (matches(entity, minimum, maximum, center, squared_radius))
+            {
+              entities[found] = entity;
+              found++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return found;
+}
+
+quantity entities_within_radius(
+    const vector center,
+    const f32 radius,
+    index *const entities,
+    const quantity maximum_entities)
+{
+  vector minimum, maximum;
+  subtract_f32s_f32(center, radius, minimum, VECTOR_COMPONENTS);
+  add_f32s_f32(center, radius, maximum, VECTOR_COMPONENTS);
+  return search(minimum, maximum, center, radius * radius, entities, maximum_entities);
+}
+
+quantity entities_within_bounds(
+    const vector minimum,
+    const vector maximum,
+    index *const entities,
+    const quantity maximum_entities)
+{
+  return search(minimum, maximum, minimum, POSITIVE_INFINITY, entities, maximum_entities);
+}
+
+static void consider_nearest(
+    const index entity,
+    const vector location,
+    index *const entities,
+    quantity *const found,
+    const quantity wanted)
+{
+  if (considered_queries[entity] == queries)
+  {
+    return;
+  }
+
+  considered_queries[entity] = queries;
+
+  const f32 squared_distance = squared_distance_to(entity, location);
+  index position;
+
+  if (*found < wanted)
+  {
+    position = *found;
+    (*found)++;
+  }
+  else if (squared_distance < nearest_squared_distances[wanted - 1])
+  {
+    position = wanted - 1;
+  }
+  else
+  {
+    return;
+  }
+
+  while (position > 0 && nearest_squared_distances[position - 1] > squared_distance)
+  {
+    entities[position] = entities[position - 1];
+    nearest_squared_distances[position] = nearest_squared_distances[position - 1];
+    position--;
+  }
+
+  entities[position] = entity;
+  nearest_squared_distances[position] = squared_distance;
+}
+
+quantity nearest_entities(
+    const vector location,
+    index *const entities,
+    const quantity maximum_entities)
+{
+  const quantity wanted = MIN(maximum_entities, total_indexed);
+  quantity found = 0;
+
+  if (wanted <= 0)
+  {
+    return 0;
+  }
+
+  queries++;
+
+  const s32 x = cell_of(location[0]);
+  const s32 y = cell_of(location[1]);
+  const s32 z = cell_of(location[2]);
+
+  // Searches outwards one shell of cells at a time.  Once every cell within a
+  // number of cells of that containing the location has been searched, nothing
+  // unsearched can be nearer than that many cells away.
+  for (s32 ring = 0;; ring++)
+  {
+    const f32 searched_distance = (ring - 1) * SPATIAL_INDEX_CELL_SIZE;
+
+    if (found == wanted && nearest_squared_distances[wanted - 1] <= searched_distance * searched_distance)
+    {
+      break;
+    }
+
+    const s32 width = 2 * ring + 1;
+    const quantity shell_cells = ring == 0 ? 1 : width * width * width - (width - 2) * (width - 2) * (width - 2);
+
+    if (width > SPATIAL_INDEX_CELLS_PER_AXIS || shell_cells > total_indexed)
+    {
+      for (index position = 0; position < total_indexed; position++)
+      {
+        consider_nearest(indexed_entities[position], location, entities, &found, wanted);
+      }
+
+      break;
+    }
+
+    for (s32 x_offset = -ring; x_offset <= ring; x_offset++)
+    {
+      for (s32 y_offset = -ring; y_offset <= ring; y_offset++)
+      {
+        // Only the cells on the surface of the shell are searched.
+        const s32 z_step = (x_offset == -ring || x_offset == ring || y_offset == -ring || y_offset == ring) ? 1 : 2 * ring;
+
+        for (s32 z_offset = -ring; z_offset <= ring; z_offset += z_step)
+        {
+          for (index entity = bucket_heads[bucket_of(x + x_offset, y + y_offset, z + z_offset)]; entity != INDEX_NONE; entity = next_in_buckets[entity])
+          {
+            consider_nearest(entity, location, entities, &found, wanted);
+          }
+        }
+      }
+    }
+  }
+
+  return found;
+}
@@ -0,0 +1,94 @@
+/** @file */
+
+#ifndef SPATIAL_INDEX_H
+
+#define SPATIAL_INDEX_H
+
+#include "../primitives/index.h"
+#include "../primitives/quantity.h"
+#include "../primitives/f32.h"
+#include "../math/vector.h"
+
+/**
+ * Finds entities whose locations are within a given distance of a point.
+ * @remark Entities with parents are found at their locations in world space.
+ * @remark Locations are those at the start of the current tick; entities
+ *         created or moved since are found where they were at that time, or
+ *         not at all.
+ * @param center The location to search around.
+ * @param radius The maximum distance from the center to search.
+ * @param entities The array to write the indices of found entities to, in no
+ *                 particular order.
+ * @param maximum_entities The number of elements in entities.  The search ends
+ *                         once this many entities have been found.
+ * @return The number of entities found.
+ */
+quantity entities_within_radius(
+    const vector center,
+    const f32 radius,
+    index *const entities,
+    const quantity maximum_entities);
+
+/**
+ * Finds entities whose locations are within a given axis-aligned box.
+ * @remark Entities with parents are found at their locations in world space.
+ * @remark Locations are those at the start of the current tick; entities
+ *         created or moved since are found where they were at that time, or
+ *         not at all.
+ * @param minimum The location of the corner of the box on the negative side of
+ *                every axis.
+ * @param maximum The location of the corner of the box on the positive side of
+ *                every axis.
+ * @param entities The array to write the indices of found entities to, in no
+ *                 particular order.
+ * @param maximum_entities The number of elements in entities.  The search ends
+ *                         once this many entities have been found.
+ * @return The number of entities found.
+ */
+quantity entities_within_bounds(
+    const vector minimum,
+    const vector maximum,
+    index *const entities,
+    const quantity maximum_entities);
+
+/**
+ * Finds the entities whose locations are nearest to a point.
+ * @remark Entities with parents are found at their locations in world space.
+ * @remark Locations are those at the start of the current tick; entities
+ *         created or moved since are found where they were at that time, or
+ *         not at all.
+ * @param location The location to search around.
+ * @param entities The array to write the indices of found entities to, nearest
+ *                 first.
+ * @param maximum_entities The number of elements in entities; that is, the
+ *                         number of nearest entities to find.
+ * @return The number of entities found, which is less than maximum_entities
+ *         only should there be fewer entities to find.
+ */
+quantity nearest_entities(
+    const vector location,
+    index *const entities,
+    const quantity maximum_entities);
+
+#ifndef DOXYGEN_IGNORE
+
+/**
+ * Adds an entity to the spatial index, or moves it should it already be
+ * present.
+ * @param entity The index of the entity to add.
+ * @param location The location at which to index the entity.
+ */
+void place_entity_in_spatial_index(
+    const index entity,
+    const vector location);
+
+/**
+ * Removes an entity from the spatial index.  Has no effect should it not be
+ * present.
+ * @param entity The index of the entity to remove.
+ */
+void remove_entity_from_spatial_index(const index entity);
+
+#endif
+
+#endif
@@ -18,13 +18,16 @@
 
 #include "assets/font.h"
 #include "assets/texture.h"
+#include "assets/render_texture.h"
 #include "assets/mesh.h"
 #include "assets/navigation_mesh.h"
 #include "assets/song.h"
 #include "assets/sound.h"
 
 #include "scenes/entity.h"
+#include "scenes/prefab.h"
 #include "scenes/scene.h"
+#include "scenes/spatial_index.h"
 #include "scenes/components/animated_billboard_component.h"
 #include "scenes/components/animated_mesh_component.h"
 #include "scenes/components/camera_component.h"
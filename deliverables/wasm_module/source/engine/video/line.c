@@ -32,6 +32,12 @@ void render_opaque_line(
   const s32 column_delta = rounded_end_column - rounded_start_column;
   const s32 absolute_column_delta = absolute_f32(column_delta);
 
+  mark_camera_component_dirty(
+      MIN(rounded_start_row, rounded_end_row),
+      MIN(rounded_start_column, rounded_end_column),
+      MAX(rounded_start_row, rounded_end_row) + 1,
+      MAX(rounded_start_column, rounded_end_column) + 1);
+
   s32 start_primary_axis, end_primary_axis, indices_per_primary_axis, maximum_primary_axis, indices_per_secondary_axis, maximum_secondary_axis;
   f32 starts[5], ends[5];
 
@@ -148,6 +154,12 @@ void render_blended_line(
   const s32 column_delta = rounded_end_column - rounded_start_column;
   const s32 absolute_column_delta = absolute_f32(column_delta);
 
+  mark_camera_component_dirty(
+      MIN(rounded_start_row, rounded_end_row),
+      MIN(rounded_start_column, rounded_end_column),
+      MAX(rounded_start_row, rounded_end_row) + 1,
+      MAX(rounded_start_column, rounded_end_column) + 1);
+
   s32 start_primary_axis, end_primary_axis, indices_per_primary_axis, maximum_primary_axis, indices_per_secondary_axis, maximum_secondary_axis;
   f32 starts[6], ends[6];
 
@@ -5,6 +5,7 @@
 #include "../math/relational.h"
 #include "../math/float.h"
 #include "../scenes/components/camera_component.h"
+#include "../scenes/components/selectable_component.h"
 
 static void sort_top_to_bottom(
     f32 *const vertices,
@@ -62,6 +63,24 @@ static void sort_top_to_bottom(
   }
 }
 
+// Rather than writing an identifier per pixel, only the pixel under the pointer
+// is picked, by checking whether each row which covers it changes its depth.
+static index picking_index_of(
+    const s32 camera_row,
+    const s32 clamped_left_camera_column,
+    const s32 clamped_right_camera_column,
+    const index left_index)
+{
+  if (camera_row == camera_component_picking_row && camera_component_picking_column >= clamped_left_camera_column && camera_component_picking_column < clamped_right_camera_column)
+  {
+    return left_index + camera_component_picking_column - clamped_left_camera_column;
+  }
+  else
+  {
+    return INDEX_NONE;
+  }
+}
+
 static void render_opaque_row(
     const quantity texture_rows,
     const quantity texture_rows_minus_one,
@@ -105,8 +124,12 @@ static void render_opaque_row(
 
   clamped_right_camera_column = MIN(clamped_right_camera_column, camera_component_columns);
 
+  mark_camera_component_dirty(camera_row, clamped_left_camera_column, camera_row + 1, clamped_right_camera_column);
+
   const index left_index = camera_row * camera_component_columns + clamped_left_camera_column;
   const index right_index = left_index + clamped_right_camera_column - clamped_left_camera_column;
+  const index picking_index = picking_index_of(camera_row, clamped_left_camera_column, clamped_right_camera_column, left_index);
+  const f32 picking_depth = picking_index == INDEX_NONE ? 0.0f : camera_component_depths[picking_index];
 
   for (index camera_index = left_index; camera_index < right_index; camera_index++)
   {
@@ -131,6 +154,11 @@ static void render_opaque_row(
 
     add_f32s_f32s(accumulators, per_columns, accumulators, 6);
   }
+
+  if (picking_index != INDEX_NONE && camera_component_depths[picking_index] != picking_depth)
+  {
+    selectable_component_picked = selectable_component_rendering;
+  }
 }
 
 void render_opaque_triangle(
@@ -321,8 +349,12 @@ static void render_cutout_row(
 
   clamped_right_camera_column = MIN(clamped_right_camera_column, camera_component_columns);
 
+  mark_camera_component_dirty(camera_row, clamped_left_camera_column, camera_row + 1, clamped_right_camera_column);
+
   const index left_index = camera_row * camera_component_columns + clamped_left_camera_column;
   const index right_index = left_index + clamped_right_camera_column - clamped_left_camera_column;
+  const index picking_index = picking_index_of(camera_row, clamped_left_camera_column, clamped_right_camera_column, left_index);
+  const f32 picking_depth = picking_index == INDEX_NONE ? 0.0f : camera_component_depths[picking_index];
 
   for (index camera_index = left_index; camera_index < right_index; camera_index++)
   {
@@ -351,6 +383,11 @@ static void render_cutout_row(
 
     add_f32s_f32s(accumulators, per_columns, accumulators, 7);
   }
+
+  if (picking_index != INDEX_NONE && camera_component_depths[picking_index] != picking_depth)
+  {
+    selectable_component_picked = selectable_component_rendering;
+  }
 }
 
 void render_cutout_triangle(
@@ -549,6 +586,8 @@ static void render_additive_row(
 
   clamped_right_camera_column = MIN(clamped_right_camera_column, camera_component_columns);
 
+  mark_camera_component_dirty(camera_row, clamped_left_camera_column, camera_row + 1, clamped_right_camera_column);
+
   const index left_index = camera_row * camera_component_columns + clamped_left_camera_column;
   const index right_index = left_index + clamped_right_camera_column - clamped_left_camera_column;
 
@@ -762,6 +801,8 @@ static void render_blended_row(
 
   clamped_right_camera_column = MIN(clamped_right_camera_column, camera_component_columns);
 
+  mark_camera_component_dirty(camera_row, clamped_left_camera_column, camera_row + 1, clamped_right_camera_column);
+
   const index left_index = camera_row * camera_component_columns + clamped_left_camera_column;
   const index right_index = left_index + clamped_right_camera_column - clamped_left_camera_column;
 
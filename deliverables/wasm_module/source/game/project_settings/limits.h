@@ -34,6 +34,18 @@
  */
 #define MAXIMUM_CAMERA_COMPONENTS 4
 
+/**
+ * The maximum number of selectable components which may exist at any given
+ * time.
+ */
+#define MAXIMUM_SELECTABLE_COMPONENTS 8
+
+/**
+ * The maximum number of navigation mesh components which may exist at any
+ * given time.
+ */
+#define MAXIMUM_NAVIGATION_MESH_COMPONENTS 8
+
 /**
  * The maximum number of mesh components which may exist at any given time.
  */
@@ -56,4 +68,33 @@
  */
 #define MAXIMUM_ADDITIVE_BLENDED_MESH_COMPONENTS 8
 
+/**
+ * The maximum number of faces which may exist in a navigation mesh which is
+ * used to find paths (see @ref navigation_mesh_path).
+ */
+#define MAXIMUM_FACES_PER_NAVIGATION_MESH 256
+
+/**
+ * The maximum number of paths found over navigation meshes which are kept for
+ * re-use at any given time.  Agents which repeatedly find paths between the
+ * same faces (most commonly, to the same goal while moving) skip straight to
+ * string pulling when a cached path is found.
+ */
+#define MAXIMUM_CACHED_NAVIGATION_MESH_PATHS 16
+
+/**
+ * The maximum number of flow fields over navigation meshes which are kept for
+ * re-use at any given time (see @ref navigation_mesh_flow).  Each is built
+ * once per goal face and shared by everything moving towards that goal face.
+ */
+#define MAXIMUM_CACHED_NAVIGATION_MESH_FLOW_FIELDS 4
+
+/**
+ * The maximum number of scenes which may be kept as snapshots for instant
+ * re-entry at any given time (see @ref snapshot_scene).  Must be at least 1.
+ * Each requires enough memory to hold a copy of the state of every entity and
+ * component pool.
+ */
+#define MAXIMUM_SCENE_SNAPSHOTS 2
+
 #endif
@@ -0,0 +1,23 @@
+/** @file */
+
+#ifndef SPATIAL_INDEX_SETTINGS_H
+
+#define SPATIAL_INDEX_SETTINGS_H
+
+/**
+ * The width, height and depth of each cell of the spatial index, in meters.
+ * This should be around the distance over which proximity is typically queried;
+ * much smaller makes radius queries visit many empty cells, while much larger
+ * makes them test many distant entities.
+ */
+#define SPATIAL_INDEX_CELL_SIZE 4.0f
+
+/**
+ * The number of cells along each axis of the spatial index before it wraps
+ * around.  Must be a power of two.  The grid is unbounded, but cells this many
+ * apart share storage, so should be large enough that the play area rarely
+ * spans it.
+ */
+#define SPATIAL_INDEX_CELLS_PER_AXIS 16
+
+#endif
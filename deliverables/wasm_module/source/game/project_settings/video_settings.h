@@ -24,4 +24,20 @@
  */
 #define SAFE_AREA_COLUMNS 320
 
+/**
+ * The render textures which camera components can render into, and which
+ * meshes can then sample as textures.  Each is an invocation of the given
+ * macro with a name, a height in pixel rows and a width in pixel columns, e.g.:
+ *
+ * @code{.c}
+ * #define RENDER_TEXTURE_LIST(item) \
+ *   item(game_mirror, 64, 32)        \
+ *   item(game_background, 180, 320)
+ * @endcode
+ *
+ * Each name becomes a texture factory (e.g. `const texture * game_mirror();`)
+ * alongside a render texture (e.g. `game_mirror_render_texture`).
+ */
+#define RENDER_TEXTURE_LIST(item)
+
 #endif
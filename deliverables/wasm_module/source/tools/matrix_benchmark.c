@@ -0,0 +1,176 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+// The engine's math is included directly so that the same implementations
+// (including any vectorized paths available to the native compiler) are
+// measured.
+#include "../engine/math/trigonometry.c"
+#include "../engine/math/matrix.c"
+
+#define MATRICES 1024
+#define ITERATIONS 5000
+#define REPETITIONS 10
+
+typedef void multiply(const matrix multiplier, const matrix multiplicand, matrix product);
+
+// The scalar implementation of multiply_matrices prior to vectorization, as a
+// baseline.
+static void previous_multiply_matrices(
+    const matrix multiplier,
+    const matrix multiplicand,
+    matrix product)
+{
+  const f32 multiplier_0_0 = multiplier[0][0];
+  const f32 multiplier_0_1 = multiplier[0][1];
+  const f32 multiplier_0_2 = multiplier[0][2];
+  const f32 multiplier_0_3 = multiplier[0][3];
+  const f32 multiplier_1_0 = multiplier[1][0];
+  const f32 multiplier_1_1 = multiplier[1][1];
+  const f32 multiplier_1_2 = multiplier[1][2];
+  const f32 multiplier_1_3 = multiplier[1][3];
+  const f32 multiplier_2_0 = multiplier[2][0];
+  const f32 multiplier_2_1 = multiplier[2][1];
+  const f32 multiplier_2_2 = multiplier[2][2];
+  const f32 multiplier_2_3 = multiplier[2][3];
+  const f32 multiplier_3_0 = multiplier[3][0];
+  const f32 multiplier_3_1 = multiplier[3][1];
+  const f32 multiplier_3_2 = multiplier[3][2];
+  const f32 multiplier_3_3 = multiplier[3][3];
+
+  const f32 multiplicand_0_0 = multiplicand[0][0];
+  const f32 multiplicand_0_1 = multiplicand[0][1];
+  const f32 multiplicand_0_2 = multiplicand[0][2];
+  const f32 multiplicand_0_3 = multiplicand[0][3];
+  const f32 multiplicand_1_0 = multiplicand[1][0];
+  const f32 multiplicand_1_1 = multiplicand[1][1];
+  const f32 multiplicand_1_2 = multiplicand[1][2];
+  const f32 multiplicand_1_3 = multiplicand[1][3];
+  const f32 multiplicand_2_0 = multiplicand[2][0];
+  const f32 multiplicand_2_1 = multiplicand[2][1];
+  const f32 multiplicand_2_2 = multiplicand[2][2];
+  const f32 multiplicand_2_3 = multiplicand[2][3];
+  const f32 multiplicand_3_0 = multiplicand[3][0];
+  const f32 multiplicand_3_1 = multiplicand[3][1];
+  const f32 multiplicand_3_2 = multiplicand[3][2];
+  const f32 multiplicand_3_3 = multiplicand[3][3];
+
+  product[0][0] = multiplicand_0_0 * multiplier_0_0 + multiplicand_1_0 * multiplier_0_1 + multiplicand_2_0 * multiplier_0_2 + multiplicand_3_0 * multiplier_0_3;
+  product[0][1] = multiplicand_0_1 * multiplier_0_0 + multiplicand_1_1 * multiplier_0_1 + multiplicand_2_1 * multiplier_0_2 + multiplicand_3_1 * multiplier_0_3;
+  product[0][2] = multiplicand_0_2 * multiplier_0_0 + multiplicand_1_2 * multiplier_0_1 + multiplicand_2_2 * multiplier_0_2 + multiplicand_3_2 * multiplier_0_3;
+  product[0][3] = multiplicand_0_3 * multiplier_0_0 + multiplicand_1_3 * multiplier_0_1 + multiplicand_2_3 * multiplier_0_2 + multiplicand_3_3 * multiplier_0_3;
+  product[1][0] = multiplicand_0_0 * multiplier_1_0 + multiplicand_1_0 * multiplier_1_1 + multiplicand_2_0 * multiplier_1_2 + multiplicand_3_0 * multiplier_1_3;
+  product[1][1] = multiplicand_0_1 * multiplier_1_0 + multiplicand_1_1 * multiplier_1_1 + multiplicand_2_1 * multiplier_1_2 + multiplicand_3_1 * multiplier_1_3;
+  product[1][2] = multiplicand_0_2 * multiplier_1_0 + multiplicand_1_2 * multiplier_1_1 + multiplicand_2_2 * multiplier_1_2 + multiplicand_3_2 * multiplier_1_3;
+  product[1][3] = multiplicand_0_3 * multiplier_1_0 + multiplicand_1_3 * multiplier_1_1 + multiplicand_2_3 * multiplier_1_2 + multiplicand_3_3 * multiplier_1_3;
+  product[2][0] = multiplicand_0_0 * multiplier_2_0 + multiplicand_1_0 * multiplier_2_1 + multiplicand_2_0 * multiplier_2_2 + multiplicand_3_0 * multiplier_2_3;
+  product[2][1] = multiplicand_0_1 * multiplier_2_0 + multiplicand_1_1 * multiplier_2_1 + multiplicand_2_1 * multiplier_2_2 + multiplicand_3_1 * multiplier_2_3;
+  product[2][2] = multiplicand_0_2 * multiplier_2_0 + multiplicand_1_2 * multiplier_2_1 + multiplicand_2_2 * multiplier_2_2 + multiplicand_3_2 * multiplier_2_3;
+  product[2][3] = multiplicand_0_3 * multiplier_2_0 + multiplicand_1_3 * multiplier_2_1 + multiplicand_2_3 * multiplier_2_2 + multiplicand_3_3 * multiplier_2_3;
+  product[3][0] = multiplicand_0_0 * multiplier_3_0 + multiplicand_1_0 * multiplier_3_1 + multiplicand_2_0 * multiplier_3_2 + multiplicand_3_0 * multiplier_3_3;
+  product[3][1] = multiplicand_0_1 * multiplier_3_0 + multiplicand_1_1 * multiplier_3_1 + multiplicand_2_1 * multiplier_3_2 + multiplicand_3_1 * multiplier_3_3;
+  product[3][2] = multiplicand_0_2 * multiplier_3_0 + multiplicand_1_2 * multiplier_3_1 + multiplicand_2_2 * multiplier_3_2 + multiplicand_3_2 * multiplier_3_3;
+  product[3][3] = multiplicand_0_3 * multiplier_3_0 + multiplicand_1_3 * multiplier_3_1 + multiplicand_2_3 * multiplier_3_2 + multiplicand_3_3 * multiplier_3_3;
+}
+
+static matrix multipliers[MATRICES];
+static matrix multiplicands[MATRICES];
+static matrix products[MATRICES];
+static matrix expected[MATRICES];
+
+static double measure(multiply *const implementation)
+{
+  // The fastest repetition is least affected by anything else running.
+  double fastest = 0.0;
+
+  for (int repetition = 0; repetition < REPETITIONS; repetition++)
+  {
+    const clock_t start = clock();
+
+    for (int iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+      for (int matrix_index = 0; matrix_index < MATRICES; matrix_index++)
+      {
+        implementation(multipliers[matrix_index], multiplicands[matrix_index], products[matrix_index]);
+      }
+    }
+
+    const double nanoseconds = (double)(clock() - start) * 1000000000.0 / CLOCKS_PER_SEC / ((double)ITERATIONS * MATRICES);
+
+    if (repetition == 0 || nanoseconds < fastest)
+    {
+      fastest = nanoseconds;
+    }
+  }
+
+  return fastest;
+}
+
+static int matches_expected(void)
+{
+  for (int matrix_index = 0; matrix_index < MATRICES; matrix_index++)
+  {
+    for (int row = 0; row < MATRIX_ROWS; row++)
+    {
+      for (int column = 0; column < MATRIX_COLUMNS; column++)
+      {
+        if (products[matrix_index][row][column] != expected[matrix_index][row][column])
+        {
+          return 0;
+        }
+      }
+    }
+  }
+
+  return 1;
+}
+
+static double baseline;
+
+static void report(const char *const name, multiply *const implementation)
+{
+  const double nanoseconds = measure(implementation);
+  printf("%-36s %8.2f ns %8.2fx %s\n", name, nanoseconds, baseline / nanoseconds, matches_expected() ? "" : "(MISMATCH)");
+}
+
+int main(void)
+{
+  srand(0);
+
+  for (int matrix_index = 0; matrix_index < MATRICES; matrix_index++)
+  {
+    vector location, rotation, scale;
+
+    for (int component = 0; component < VECTOR_COMPONENTS; component++)
+    {
+      location[component] = (f32)rand() / RAND_MAX * 20.0f - 10.0f;
+      rotation[component] = (f32)rand() / RAND_MAX * 6.0f - 3.0f;
+      scale[component] = (f32)rand() / RAND_MAX + 0.5f;
+    }
+
+    model(location, rotation, scale, multiplicands[matrix_index], NULL);
+
+    for (int component = 0; component < VECTOR_COMPONENTS; component++)
+    {
+      location[component] = (f32)rand() / RAND_MAX * 20.0f - 10.0f;
+      rotation[component] = (f32)rand() / RAND_MAX * 6.0f - 3.0f;
+    }
+
+    model(location, rotation, scale, multipliers[matrix_index], NULL);
+  }
+
+  printf("%-36s %11s %9s\n", "implementation", "per call", "speedup");
+
+  for (int matrix_index = 0; matrix_index < MATRICES; matrix_index++)
+  {
+    previous_multiply_matrices(multipliers[matrix_index], multiplicands[matrix_index], expected[matrix_index]);
+  }
+
+  baseline = measure(previous_multiply_matrices);
+  report("previous_multiply_matrices", previous_multiply_matrices);
+  report("multiply_matrices", multiply_matrices);
+  report("multiply_matrix_by_affine_matrix", multiply_matrix_by_affine_matrix);
+  report("multiply_affine_matrices", multiply_affine_matrices);
+
+  return 0;
+}
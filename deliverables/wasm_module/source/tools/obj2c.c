@@ -651,6 +651,86 @@ static void obj_type(
   }
 }
 
+static const float *bounding_volume_face_centers;
+static int bounding_volume_axis;
+
+static int compare_bounding_volume_faces(const void *a, const void *b)
+{
+  const float first = bounding_volume_face_centers[*(const int *)a * 3 + bounding_volume_axis];
+  const float second = bounding_volume_face_centers[*(const int *)b * 3 + bounding_volume_axis];
+  return first < second ? -1 : first > second ? 1 : 0;
+}
+
+// Builds the node of a bounding volume hierarchy containing a range of faces,
+// followed by its children (depth-first), returning the index of the node
+// which follows them.  Each node is split at the median face along the axis
+// over which the centers of its faces are most spread, so that the hierarchy
+// is balanced.
+static int build_bounding_volume_hierarchy(
+    int *const face_order,
+    const int first_face,
+    const int count,
+    const float *const face_minimums,
+    const float *const face_maximums,
+    float *const node_minimums,
+    float *const node_maximums,
+    int *const node_second_children,
+    int *const node_faces,
+    const int node)
+{
+  float *const minimum = &node_minimums[node * 3];
+  float *const maximum = &node_maximums[node * 3];
+  float center_minimum[3];
+  float center_maximum[3];
+
+  for (int component = 0; component < 3; component++)
+  {
+    minimum[component] = center_minimum[component] = INFINITY;
+    maximum[component] = center_maximum[component] = -INFINITY;
+  }
+
+  for (int order_index = first_face; order_index < first_face + count; order_index++)
+  {
+    const int face_index = face_order[order_index];
+
+    for (int component = 0; component < 3; component++)
+    {
+      const float center = bounding_volume_face_centers[face_index * 3 + component];
+      minimum[component] = fminf(minimum[component], face_minimums[face_index * 3 + component]);
+      maximum[component] = fmaxf(maximum[component], face_maximums[face_index * 3 + component]);
+      center_minimum[component] = fminf(center_minimum[component], center);
+      center_maximum[component] = fmaxf(center_maximum[component], center);
+    }
+  }
+
+  if (count == 1)
+  {
+    node_second_children[node] = -1;
+    node_faces[node] = face_order[first_face];
+    return node + 1;
+  }
+  else
+  {
+    bounding_volume_axis = 0;
+
+    for (int component = 1; component < 3; component++)
+    {
+      if (center_maximum[component] - center_minimum[component] > center_maximum[bounding_volume_axis] - center_minimum[bounding_volume_axis])
+      {
+        bounding_volume_axis = component;
+      }
+    }
+
+    qsort(&face_order[first_face], count, sizeof(int), compare_bounding_volume_faces);
+
+    const int first_count = count / 2;
+    const int second_child = build_bounding_volume_hierarchy(face_order, first_face, first_count, face_minimums, face_maximums, node_minimums, node_maximums, node_second_children, node_faces, node + 1);
+    node_second_children[node] = second_child;
+    node_faces[node] = -1;
+    return build_bounding_volume_hierarchy(face_order, first_face + first_count, count - first_count, face_minimums, face_maximums, node_minimums, node_maximums, node_second_children, node_faces, second_child);
+  }
+}
+
 static void obj_end_object()
 {
   if (object_name != NULL)
@@ -669,7 +749,7 @@ static void obj_end_object()
         write("Failed to write a navigation mesh's vertex counts.", "%s%d", face_index ? ", " : "", face_lengths[face_index]);
       }
 
-      write("Failed to write the footer of a navigation mesh's vertex counts and the header of its neighbor faces.", "};\n\nstatic const index %s_%s_%d_neighbor_faces[] = {", name_prefix, name, object_name);
+      write("Failed to write the footer of a navigation mesh's vertex counts and the header of its neighbor faces.", "};\n\nstatic const index %s_%s_%s_neighbor_faces[] = {", name_prefix, name, object_name);
 
       float *face_surface_normals = malloc_or_exit("Failed to allocate a list of face surface normals.", sizeof(float) * faces * 3);
       int *face_neighbor_faces = malloc_or_exit("Failed to allocate a list of face neighbor faces.", sizeof(int) * face_indices_length);
@@ -688,11 +768,11 @@ static void obj_end_object()
         {
           const int first_index = face_vertex_indices[first_face_index_offset + first_vertex_index];
           const int next_first_index = face_vertex_indices[first_face_index_offset + ((first_vertex_index + 1) % first_face_length)];
-          const float *const first_vertex_location = &vertices[first_index];
+          const float *const first_vertex_location = &vertices[first_index * 7];
 
           for (int second_vertex_index = first_vertex_index + 1; second_vertex_index < first_face_length; second_vertex_index++)
           {
-            const float *const second_vertex_location = &vertices[face_vertex_indices[first_face_index_offset + second_vertex_index]];
+            const float *const second_vertex_location = &vertices[face_vertex_indices[first_face_index_offset + second_vertex_index] * 7];
 
             if (equal(first_vertex_location, second_vertex_location))
             {
@@ -1081,7 +1161,66 @@ static void obj_end_object()
         face_index_offset += face_lengths[face_index];
       }
 
-      write("Failed to write the footer of a navigation mesh.", "};\n\nconst navigation_mesh %s_%s_%s = {%d, %s_%s_%s_vertex_counts, %s_%s_%s_neighbor_face_re_mappings, %s_%s_%s_neighbor_edge_re_mappings, %s_%s_%s_vertex_location_re_mappings, %s_%s_%s_surface_normals, %s_%s_%s_edge_exit_normal_re_mappings, %s_%s_%s_edge_exit_intersection_normal_re_mappings, %s_%s_%s_edge_coefficient_re_mappings, %s_%s_%s_edge_midpoint_distance_re_mappings, %s_%s_%s_edge_midpoint_center_distance_re_mappings};\n", name_prefix, name, object_name, faces, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name);
+      write("Failed to write the footer of a navigation mesh's edge midpoint center distance re-mappings.", "};\n\n");
+
+      float *face_minimums = malloc_or_exit("Failed to allocate a list of face minimums.", sizeof(float) * faces * 3);
+      float *face_maximums = malloc_or_exit("Failed to allocate a list of face maximums.", sizeof(float) * faces * 3);
+      float *face_centers = malloc_or_exit("Failed to allocate a list of face centers.", sizeof(float) * faces * 3);
+      int *face_order = malloc_or_exit("Failed to allocate a list of face orders.", sizeof(int) * faces);
+
+      face_index_offset = 0;
+
+      for (int face_index = 0; face_index < faces; face_index++)
+      {
+        const int face_length = face_lengths[face_index];
+
+        for (int component = 0; component < 3; component++)
+        {
+          face_minimums[face_index * 3 + component] = INFINITY;
+          face_maximums[face_index * 3 + component] = -INFINITY;
+          face_centers[face_index * 3 + component] = 0;
+        }
+
+        for (int vertex_index = 0; vertex_index < face_length; vertex_index++)
+        {
+          const float *const vertex_location = &vertices[face_vertex_indices[face_index_offset + vertex_index] * 7];
+
+          for (int component = 0; component < 3; component++)
+          {
+            face_minimums[face_index * 3 + component] = fminf(face_minimums[face_index * 3 + component], vertex_location[component]);
+            face_maximums[face_index * 3 + component] = fmaxf(face_maximums[face_index * 3 + component], vertex_location[component]);
+            face_centers[face_index * 3 + component] += vertex_location[component] / face_length;
+          }
+        }
+
+        face_order[face_index] = face_index;
+        face_index_offset += face_length;
+      }
+
+      const int bounding_volumes = faces * 2 - 1;
+      float *bounding_volume_minimums = malloc_or_exit("Failed to allocate a list of bounding volume minimums.", sizeof(float) * bounding_volumes * 3);
+      float *bounding_volume_maximums = malloc_or_exit("Failed to allocate a list of bounding volume maximums.", sizeof(float) * bounding_volumes * 3);
+      int *bounding_volume_second_children = malloc_or_exit("Failed to allocate a list of bounding volume second children.", sizeof(int) * bounding_volumes);
+      int *bounding_volume_faces = malloc_or_exit("Failed to allocate a list of bounding volume faces.", sizeof(int) * bounding_volumes);
+
+      bounding_volume_face_centers = face_centers;
+      build_bounding_volume_hierarchy(face_order, 0, faces, face_minimums, face_maximums, bounding_volume_minimums, bounding_volume_maximums, bounding_volume_second_children, bounding_volume_faces, 0);
+
+      write_float_array("Failed to write a navigation mesh's bounding volume minimums.", bounding_volume_minimums, bounding_volumes * 3, "%s_%s_%s_bounding_volume_minimums", name_prefix, name, object_name);
+      write_float_array("Failed to write a navigation mesh's bounding volume maximums.", bounding_volume_maximums, bounding_volumes * 3, "%s_%s_%s_bounding_volume_maximums", name_prefix, name, object_name);
+      write_int_array("Failed to write a navigation mesh's bounding volume second children.", bounding_volume_second_children, bounding_volumes, "index", "%s_%s_%s_bounding_volume_second_children", name_prefix, name, object_name);
+      write_int_array("Failed to write a navigation mesh's bounding volume faces.", bounding_volume_faces, bounding_volumes, "index", "%s_%s_%s_bounding_volume_faces", name_prefix, name, object_name);
+
+      write("Failed to write the footer of a navigation mesh.", "\nconst navigation_mesh %s_%s_%s = {%d, %s_%s_%s_vertex_counts, %s_%s_%s_neighbor_face_re_mappings, %s_%s_%s_neighbor_edge_re_mappings, %s_%s_%s_vertex_location_re_mappings, %s_%s_%s_surface_normals, %s_%s_%s_edge_exit_normal_re_mappings, %s_%s_%s_edge_exit_intersection_normal_re_mappings, %s_%s_%s_edge_coefficient_re_mappings, %s_%s_%s_edge_midpoint_distance_re_mappings, %s_%s_%s_edge_midpoint_center_distance_re_mappings, %s_%s_%s_bounding_volume_minimums, %s_%s_%s_bounding_volume_maximums, %s_%s_%s_bounding_volume_second_children, %s_%s_%s_bounding_volume_faces};\n", name_prefix, name, object_name, faces, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name, name_prefix, name, object_name);
+
+      free(bounding_volume_faces);
+      free(bounding_volume_second_children);
+      free(bounding_volume_maximums);
+      free(bounding_volume_minimums);
+      free(face_order);
+      free(face_centers);
+      free(face_maximums);
+      free(face_minimums);
 
       free(face_edge_exit_normals);
       free(face_surface_normals);
@@ -2325,19 +2464,13 @@ static void obj_forward_slash()
     }
     else if (index > 0 && index <= vertices_length)
     {
-      if (!object_is_navigation_mesh)
-      {
-        face_vertex_indices[face_indices_length - 1] = index - 1;
-      }
+      face_vertex_indices[face_indices_length - 1] = index - 1;
       state = STATE_OBJ_F_V_SEPARATOR;
       return;
     }
     else if (index < 0 && index >= -vertices_length)
     {
-      if (!object_is_navigation_mesh)
-      {
-        face_vertex_indices[face_indices_length - 1] = vertices_length + index;
-      }
+      face_vertex_indices[face_indices_length - 1] = vertices_length + index;
       state = STATE_OBJ_F_V_SEPARATOR;
       return;
     }